@@ -0,0 +1,68 @@
+/*
+ * AdaptiveRate.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include "AdaptiveRate.h"
+
+AdaptiveRate::AdaptiveRate(uint16_t min_ticks, uint16_t max_ticks)
+{
+    min_interval = min_ticks;
+    max_interval = max_ticks;
+    interval = min_ticks;
+    have_last = 0;
+}
+
+/**
+ * @brief  Forget the previous reading after a failed one: the change
+ *         across the gap is not counted. The interval is kept, a missing
+ *         sensor is not polled faster.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void AdaptiveRate::reset()
+{
+    have_last = 0;
+}
+
+/**
+ * @brief  New valid reading: next sampling interval.
+ * @param  temp: tenths of oC.
+ * @param  humi: tenths of %RH.
+ * @param  elapsed: ticks since the previous reading.
+ *
+ * @retval Ticks to the next reading.
+ */
+uint16_t AdaptiveRate::update(int16_t temp, uint16_t humi, uint16_t elapsed)
+{
+    uint16_t dt, dh;
+
+    if (!have_last || !elapsed) {
+        have_last = 1;
+        last_temp = temp;
+        last_humi = humi;
+
+        return interval;
+    }
+
+    dt = temp > last_temp ? temp - last_temp : last_temp - temp;
+    dh = humi > last_humi ? humi - last_humi : last_humi - humi;
+
+    last_temp = temp;
+    last_humi = humi;
+
+    if (dt >= ADAPTIVE_TEMP_STEP || dh >= ADAPTIVE_HUMI_STEP) {
+        /* Fast event: sensor limit until it settles */
+        interval = min_interval;
+    }
+    else if ((uint32_t)dt * max_interval < (uint32_t)ADAPTIVE_TEMP_STEP * elapsed &&
+             (uint32_t)dh * max_interval < (uint32_t)ADAPTIVE_HUMI_STEP * elapsed) {
+        /* Less than a step over the longest interval: back off */
+        interval = interval > max_interval / 2 ? max_interval : interval * 2;
+    }
+
+    return interval;
+}
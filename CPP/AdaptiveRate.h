@@ -0,0 +1,50 @@
+/*
+ * AdaptiveRate.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Sampling interval that follows the rate of change of the readings.
+ *      A reading that moved by a step or more since the previous one
+ *      drops the interval to the minimum; while the change projected over
+ *      the maximum interval stays below a step, the interval doubles up
+ *      to the maximum. Intervals are in watchdog ticks.
+ *
+ *          AdaptiveRate rate(2, 22);
+ *          ticks = rate.update(temp, humi, ticks_since_last);
+ */
+
+#ifndef ADAPTIVERATE_H_
+#define ADAPTIVERATE_H_
+
+#include <stdint.h>
+
+/* Changes that count as an event: tenths of oC and tenths of %RH */
+#ifndef ADAPTIVE_TEMP_STEP
+#define ADAPTIVE_TEMP_STEP      3
+#endif
+#ifndef ADAPTIVE_HUMI_STEP
+#define ADAPTIVE_HUMI_STEP      10
+#endif
+
+class AdaptiveRate
+{
+public:
+    AdaptiveRate(uint16_t min_ticks, uint16_t max_ticks);
+
+    uint16_t update(int16_t temp, uint16_t humi, uint16_t elapsed);
+    void reset();
+    uint16_t get_interval() { return interval; }
+
+private:
+    uint16_t min_interval;
+    uint16_t max_interval;
+    uint16_t interval;
+
+    /* Previous valid reading */
+    uint8_t have_last;
+    int16_t last_temp;
+    uint16_t last_humi;
+};
+
+#endif /* ADAPTIVERATE_H_ */
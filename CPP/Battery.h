@@ -8,8 +8,20 @@
 #ifndef BATTERY_H_
 #define BATTERY_H_
 
+#include <msp430.h>
 #include <stdint.h>
 
+#include "lib/pin.h"
+#include "lib/adc10.h"
+#include "lib/fixed.h"
+
+/* Volts, Q12: 0 to 16V in steps of 0.24mV */
+typedef Fixed<12, uint16_t> Volts;
+
+/* ADC10 reference: VCC */
+#define BATTERY_VREF_MV     3300
+
+template <class AIN>
 class Battery
 {
 public:
@@ -17,11 +29,44 @@ public:
     // virtual ~Battery();
 
     uint16_t get_voltage();
+    uint16_t get_millivolts();
+    Volts get_volts() { return volts; }
 
 private:
-
-    uint16_t voltage;
+    Volts volts;
 
 };
 
+template <class AIN>
+Battery<AIN>::Battery()
+{
+    /* ADC option select: the ADC itself is only on during a
+     * conversion (lib/adc10.h) */
+    adc10_enable_inputs(AIN::ae_mask);
+
+    volts = Volts::from_raw(0);
+}
+
+template <class AIN>
+uint16_t Battery<AIN>::get_voltage(){
+    uint16_t raw = adc10_read(AIN::inch, ADC10_REF_VCC, 1);
+
+    /* raw / 1024 in Q12, times VREF */
+    volts = Volts::from_raw((uint16_t)(raw << 2)) *
+            Volts::constant<BATTERY_VREF_MV, 1000>();
+
+    return (uint16_t)volts.to_scaled<10>();
+}
+
+/**
+ * @brief  Last conversion of get_voltage() in mV.
+ * @param  Nenhum
+ *
+ * @retval Voltage in mV.
+ */
+template <class AIN>
+uint16_t Battery<AIN>::get_millivolts(){
+    return (uint16_t)volts.to_scaled<1000>();
+}
+
 #endif /* BATTERY_H_ */
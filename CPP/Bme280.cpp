@@ -0,0 +1,118 @@
+/*
+ * Bme280.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <lib/i2c_master_f247_g2xxx.h>
+#include <lib/timer_delay.h>
+
+#include "Bme280.h"
+
+Bme280::Bme280(uint8_t i2c_addr)
+{
+    my_i2c_addr = i2c_addr;
+}
+
+/**
+ * @brief  Check chip ID and read the compensation parameters.
+ *         Call after I2C initialization.
+ * @param  Nenhum
+ *
+ * @retval 1 if the sensor was found.
+ */
+uint8_t Bme280::init()
+{
+    uint8_t data[7];
+
+    if (i2c_master_read_reg(my_i2c_addr, BME280_REG_CHIP_ID, 1, data) != IDLE_MODE)
+        return 0;
+
+    if (data[0] != BME280_CHIP_ID)
+        return 0;
+
+    /* dig_T1..dig_T3: little endian */
+    if (i2c_master_read_reg(my_i2c_addr, BME280_REG_CALIB_T, 6, data) != IDLE_MODE)
+        return 0;
+
+    dig_T1 = data[1] << 8 | data[0];
+    dig_T2 = (int16_t)(data[3] << 8 | data[2]);
+    dig_T3 = (int16_t)(data[5] << 8 | data[4]);
+
+    if (i2c_master_read_reg(my_i2c_addr, BME280_REG_CALIB_H1, 1, &dig_H1) != IDLE_MODE)
+        return 0;
+
+    /* dig_H2..dig_H6: H4 and H5 are 12-bit sharing register 0xE5 */
+    if (i2c_master_read_reg(my_i2c_addr, BME280_REG_CALIB_H2, 7, data) != IDLE_MODE)
+        return 0;
+
+    dig_H2 = (int16_t)(data[1] << 8 | data[0]);
+    dig_H3 = data[2];
+    dig_H4 = (int16_t)((int8_t)data[3] * 16 | (data[4] & 0x0F));
+    dig_H5 = (int16_t)((int8_t)data[5] * 16 | (data[4] >> 4));
+    dig_H6 = (int8_t)data[6];
+
+    return 1;
+}
+
+/**
+ * @brief  Forced mode measurement.
+ * @param  Nenhum
+ *
+ * @retval 1 if the reading is valid.
+ */
+uint8_t Bme280::read()
+{
+    uint8_t ctrl;
+    /* T msb, lsb, xlsb, H msb, lsb */
+    uint8_t data[5];
+    int32_t adc_T, adc_H;
+    int32_t var1, var2, t_fine;
+    int32_t v_x1;
+
+    /* ctrl_hum only takes effect after a write to ctrl_meas */
+    ctrl = BME280_CTRL_HUM_OSRS_X1;
+    if (i2c_master_write_reg(my_i2c_addr, BME280_REG_CTRL_HUM, &ctrl, 1) != IDLE_MODE)
+        return 0;
+
+    ctrl = BME280_CTRL_MEAS_FORCED;
+    if (i2c_master_write_reg(my_i2c_addr, BME280_REG_CTRL_MEAS, &ctrl, 1) != IDLE_MODE)
+        return 0;
+
+    timer_delay_ms(BME280_MEASUREMENT_MS);
+
+    if (i2c_master_read_reg(my_i2c_addr, BME280_REG_TEMP_MSB, sizeof(data), data) != IDLE_MODE)
+        return 0;
+
+    adc_T = (int32_t)data[0] << 12 | (int32_t)data[1] << 4 | data[2] >> 4;
+    adc_H = (int32_t)data[3] << 8 | data[4];
+
+    /* Skipped or not finished measurement */
+    if (adc_T == 0x80000 || adc_H == 0x8000)
+        return 0;
+
+    /* Datasheet 4.2.3: temperature, resolution 0.01 oC */
+    var1 = ((((adc_T >> 3) - ((int32_t)dig_T1 << 1))) * ((int32_t)dig_T2)) >> 11;
+    var2 = (((((adc_T >> 4) - ((int32_t)dig_T1)) * ((adc_T >> 4) - ((int32_t)dig_T1))) >> 12) *
+            ((int32_t)dig_T3)) >> 14;
+    t_fine = var1 + var2;
+
+    /* T = (t_fine * 5 + 128) / 256 hundredths -> t_fine / 512 tenths */
+    temperature = (int16_t)((t_fine + 256) >> 9);
+
+    /* Datasheet 4.2.3: humidity in Q22.10 %RH */
+    v_x1 = t_fine - ((int32_t)76800);
+    v_x1 = (((((adc_H << 14) - (((int32_t)dig_H4) << 20) - (((int32_t)dig_H5) * v_x1)) +
+            ((int32_t)16384)) >> 15) * (((((((v_x1 * ((int32_t)dig_H6)) >> 10) *
+            (((v_x1 * ((int32_t)dig_H3)) >> 11) + ((int32_t)32768))) >> 10) +
+            ((int32_t)2097152)) * ((int32_t)dig_H2) + 8192) >> 14));
+    v_x1 = (v_x1 - (((((v_x1 >> 15) * (v_x1 >> 15)) >> 7) * ((int32_t)dig_H1)) >> 4));
+    v_x1 = (v_x1 < 0 ? 0 : v_x1);
+    v_x1 = (v_x1 > 419430400 ? 419430400 : v_x1);
+
+    /* Q22.10 -> tenths of %: H * 10 / 1024 */
+    humidity = (uint16_t)(((v_x1 >> 12) * 5) >> 9);
+
+    return 1;
+}
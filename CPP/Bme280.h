@@ -0,0 +1,63 @@
+/*
+ * Bme280.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Bosch BME280: forced mode temperature and humidity (pressure is
+ *      skipped). Compensation uses the 32-bit integer formulas of the
+ *      datasheet: no floating point. CPU sleeps in LPM0 during the
+ *      conversion.
+ */
+
+#ifndef BME280_H_
+#define BME280_H_
+
+#include <stdint.h>
+
+#include "HygroSensor.h"
+
+#define BME280_I2C_ADDRESS          0x76
+
+/* Registers */
+#define BME280_REG_CALIB_T          0x88
+#define BME280_REG_CALIB_H1         0xA1
+#define BME280_REG_CHIP_ID          0xD0
+#define BME280_REG_CALIB_H2         0xE1
+#define BME280_REG_CTRL_HUM         0xF2
+#define BME280_REG_CTRL_MEAS        0xF4
+#define BME280_REG_TEMP_MSB         0xFA
+
+#define BME280_CHIP_ID              0x60
+/* Humidity oversampling x1 */
+#define BME280_CTRL_HUM_OSRS_X1     0x01
+/* Temperature oversampling x1, pressure skipped, forced mode */
+#define BME280_CTRL_MEAS_FORCED     0x21
+
+/* T and H oversampling x1: 1.25 + 2.3 + 2.3 + 0.575ms max */
+#define BME280_MEASUREMENT_MS       7
+
+class Bme280: public HygroSensor
+{
+public:
+    Bme280(uint8_t i2c_addr);
+
+    uint8_t init();
+    uint8_t read();
+
+private:
+    uint8_t my_i2c_addr;
+
+    /* Compensation parameters */
+    uint16_t dig_T1;
+    int16_t dig_T2;
+    int16_t dig_T3;
+    uint8_t dig_H1;
+    int16_t dig_H2;
+    uint8_t dig_H3;
+    int16_t dig_H4;
+    int16_t dig_H5;
+    int8_t dig_H6;
+};
+
+#endif /* BME280_H_ */
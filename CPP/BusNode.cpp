@@ -0,0 +1,101 @@
+/*
+ * BusNode.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <lib/rs485.h>
+
+#include "BusNode.h"
+
+BusNode::BusNode()
+{
+    head = 0;
+    count = 0;
+    my_address = 0;
+    seq = 0;
+}
+
+void BusNode::Init(uint16_t address)
+{
+    my_address = address;
+
+    init_uart();
+    init_rs485(address);
+}
+
+/**
+ * @brief  Keep a sample for the next polls. Node address and sequence
+ *         number are filled in here. The oldest sample is dropped when
+ *         the history is full.
+ * @param  sample: sample to keep.
+ *
+ * @retval Nenhum.
+ */
+void BusNode::add(telemetry_sample_t *sample)
+{
+    sample->node = my_address;
+    sample->seq = seq++;
+
+    history[head] = *sample;
+    head = (head + 1) % BUS_HISTORY_SIZE;
+    if (count < BUS_HISTORY_SIZE)
+        count++;
+}
+
+/**
+ * @brief  Answer the pending POLL, if any, with a BATCH of the samples
+ *         newer than the sequence number of the request. A sequence
+ *         number ahead of the newest sample restarts from the oldest.
+ * @param  Nenhum
+ *
+ * @retval 1 if a poll was answered.
+ */
+uint8_t BusNode::service()
+{
+    uint8_t frame[TELEMETRY_BATCH_FRAME_MAX];
+    uint8_t *payload = frame + TELEMETRY_HEADER_SIZE;
+    const uint8_t *request = rs485_request();
+    uint16_t since;
+    uint8_t max, n, i;
+    const telemetry_sample_t *sample;
+
+    if (!request)
+        return 0;
+
+    request += TELEMETRY_HEADER_SIZE;
+    since = request[TELEMETRY_POLL_SINCE] | request[TELEMETRY_POLL_SINCE + 1] << 8;
+    max = request[TELEMETRY_POLL_MAX];
+    if (max > TELEMETRY_BATCH_MAX)
+        max = TELEMETRY_BATCH_MAX;
+
+    /* Collector ahead of the newest sample: node reset or new collector.
+     * Start over from the oldest sample kept. */
+    if (count) {
+        sample = &history[(head + BUS_HISTORY_SIZE - 1) % BUS_HISTORY_SIZE];
+        if ((int16_t)(sample->seq - since) < 0)
+            since = history[(head + BUS_HISTORY_SIZE - count) % BUS_HISTORY_SIZE].seq - 1;
+    }
+
+    /* Oldest first, sequence numbers wrap around */
+    n = 0;
+    for (i=0; i < count && n < max; i++) {
+        sample = &history[(head + BUS_HISTORY_SIZE - count + i) % BUS_HISTORY_SIZE];
+
+        if ((int16_t)(sample->seq - since) > 0) {
+            telemetry_encode_sample(sample, payload + TELEMETRY_BATCH_SAMPLES + n * TELEMETRY_SAMPLE_SIZE);
+            n++;
+        }
+    }
+
+    payload[TELEMETRY_BATCH_NODE] = my_address;
+    payload[TELEMETRY_BATCH_NODE + 1] = my_address >> 8;
+    payload[TELEMETRY_BATCH_COUNT] = n;
+
+    rs485_send(frame, telemetry_close(frame, TELEMETRY_TYPE_BATCH,
+                                      TELEMETRY_BATCH_SAMPLES + n * TELEMETRY_SAMPLE_SIZE));
+    rs485_release();
+
+    return 1;
+}
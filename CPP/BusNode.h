@@ -0,0 +1,41 @@
+/*
+ * BusNode.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Node side of the polled RS-485 telemetry bus (lib/rs485.h). The
+ *      last BUS_HISTORY_SIZE samples are kept in RAM; a POLL carrying the
+ *      last sequence number the collector got is answered with the next
+ *      samples, oldest first, so nothing is lost while the collector is
+ *      busy with other nodes.
+ */
+
+#ifndef BUSNODE_H_
+#define BUSNODE_H_
+
+#include <stdint.h>
+
+#include <lib/telemetry_frame.h>
+
+#define BUS_HISTORY_SIZE    4
+
+class BusNode
+{
+public:
+    BusNode();
+
+    void Init(uint16_t address);
+    void add(telemetry_sample_t *sample);
+    uint8_t service();
+
+private:
+    telemetry_sample_t history[BUS_HISTORY_SIZE];
+    uint8_t head;
+    uint8_t count;
+
+    uint16_t my_address;
+    uint16_t seq;
+};
+
+#endif /* BUSNODE_H_ */
@@ -0,0 +1,296 @@
+/*
+ * Comfort.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include "Comfort.h"
+
+/* Magnus coefficients over water, Sonntag 1990: hPa, oC */
+#define MAGNUS_E0           6.112
+#define MAGNUS_A            17.62
+#define MAGNUS_B            243.12
+
+/* Temperature tables: -40 to 80oC every 2oC, a power of two step in Q8 */
+#define T_MIN_Q8            (-40 * 256)
+#define T_SHIFT             9
+#define T_POINTS            61
+
+/* Dew point table over gamma = ln(RH) + a.T / (b + T): -8.25 to 4.5
+ * every 0.125, Q11 */
+#define GAMMA_MIN_Q11       (-33 * 2048 / 4)
+#define GAMMA_SHIFT         8
+#define GAMMA_POINTS        103
+
+/* log2(1 + k/16): mantissa of a Q15 number */
+#define LOG2_SHIFT          11
+#define LOG2_POINTS         17
+
+/* Humidity input range, Q8 %RH: ln(0) is not defined */
+#define HUMI_MIN_Q8         (1 * 256)
+#define HUMI_MAX_Q8         (100 * 256)
+
+/* Heat index: Rothfusz regression, coefficients for oC and %RH */
+#define HI_C1               -8.78469475556
+#define HI_C2               1.61139411
+#define HI_C3               2.33854883889
+#define HI_C4               -0.14611605
+#define HI_C5               -0.012308094
+#define HI_C6               -0.0164248277778
+#define HI_C7               2.211732e-3
+#define HI_C8               7.2546e-4
+#define HI_C9               -3.582e-6
+
+/* Steadman: HI = 1.1 T - 3.9444 + 0.026111 RH. Rothfusz when the mean of
+ * this and T reaches 80oF. NWS switches with a step there, up to 1.3oC
+ * near saturation: a rounding of the inputs on the other side of the
+ * threshold moved the result by the whole step. The two are blended
+ * linearly instead while Steadman + T is within 0.5oC of the threshold
+ * (+-0.25oC of the mean): HI_BLEND_Q16 is that 1oC band, whose Q8
+ * fraction is the weight of the regression. Above 50oC the regression
+ * overflows Q16: the temperature is clamped there */
+#define HI_S0               -3.9444
+#define HI_S1               1.1
+#define HI_S2               0.026111
+#define HI_THRESHOLD        ((2.0 * 80.0 - 64.0) / 1.8)
+#define HI_BLEND_Q16        65536
+#define HI_T_MAX_Q8         (50 * 256)
+
+/* Compile time only: never called at run time */
+constexpr double comfort_exp(double x)
+{
+    double term = 1.0, sum = 1.0;
+
+    /* exp(x) = exp(x / 16)^16 */
+    x /= 16.0;
+    for (int i = 1; i < 20; i++) {
+        term *= x / i;
+        sum += term;
+    }
+    for (int i = 0; i < 4; i++)
+        sum *= sum;
+
+    return sum;
+}
+
+constexpr double comfort_ln(double x)
+{
+    /* ln(x) = 2 atanh((x - 1) / (x + 1)), x around 1 */
+    double z = (x - 1.0) / (x + 1.0);
+    double term = z, sum = 0.0;
+
+    for (int i = 1; i < 99; i += 2) {
+        sum += term / i;
+        term *= z * z;
+    }
+
+    return 2.0 * sum;
+}
+
+constexpr double comfort_log2(double x)
+{
+    int e = 0;
+
+    while (x >= 2.0) {
+        x /= 2.0;
+        e++;
+    }
+
+    return e + comfort_ln(x) / comfort_ln(2.0);
+}
+
+constexpr int32_t comfort_round(double x)
+{
+    return (int32_t)(x < 0 ? x - 0.5 : x + 0.5);
+}
+
+constexpr double magnus_gamma(double t)
+{
+    return MAGNUS_A * t / (MAGNUS_B + t);
+}
+
+struct ComfortTables {
+    int16_t gamma[T_POINTS];            /* a.T / (b + T), Q11 */
+    uint16_t vapour[T_POINTS];          /* g/m3 per %RH at T, Q14 */
+    int16_t dew_point[GAMMA_POINTS];    /* oC, Q8 */
+    uint16_t log2[LOG2_POINTS];         /* Q14 */
+
+    constexpr ComfortTables() : gamma(), vapour(), dew_point(), log2()
+    {
+        for (int i = 0; i < T_POINTS; i++) {
+            double t = -40.0 + 2.0 * i;
+            gamma[i] = (int16_t)comfort_round(magnus_gamma(t) * 2048);
+            /* 216.7 g.K/(m3.hPa) * e / T, e = 1% of saturation */
+            vapour[i] = (uint16_t)comfort_round(2.167 * MAGNUS_E0 *
+                comfort_exp(magnus_gamma(t)) / (273.15 + t) * 16384);
+        }
+
+        for (int i = 0; i < GAMMA_POINTS; i++) {
+            double g = -8.25 + 0.125 * i;
+            dew_point[i] = (int16_t)comfort_round(MAGNUS_B * g / (MAGNUS_A - g) * 256);
+        }
+
+        for (int i = 0; i < LOG2_POINTS; i++)
+            log2[i] = (uint16_t)comfort_round(comfort_log2(1.0 + i / 16.0) * 16384);
+    }
+};
+
+/* Flash: built by the compiler, no initialization code */
+static constexpr ComfortTables tables;
+
+/* log2(100 %RH in Q8) and ln(2), Q14 */
+static constexpr int32_t LOG2_HUMI_MAX_Q14 = comfort_round(comfort_log2(HUMI_MAX_Q8) * 16384);
+static constexpr int32_t LN2_Q14 = comfort_round(comfort_ln(2.0) * 16384);
+
+/**
+ * @brief  Linear interpolation in a table of equally spaced points.
+ *         Offsets outside the table give its first or last point.
+ * @param  table: points.
+ *         offset: from the first point, 1 << shift per point.
+ *         shift: log2 of the step.
+ *         points: table size.
+ *
+ * @retval Interpolated value.
+ */
+template <class T>
+static T interpolate(const T *table, int32_t offset, uint8_t shift, uint8_t points)
+{
+    uint8_t i;
+    int32_t frac;
+
+    if (offset <= 0)
+        return table[0];
+    if (offset >= ((int32_t)(points - 1) << shift))
+        return table[points - 1];
+
+    i = (uint8_t)(offset >> shift);
+    frac = offset & ((1 << shift) - 1);
+
+    return (T)(table[i] + ((((int32_t)table[i + 1] - table[i]) * frac) >> shift));
+}
+
+/**
+ * @brief  ln(RH / 100%): log2 of the normalized mantissa from a table.
+ * @param  humi: 1 to 100 %RH, clamped.
+ *
+ * @retval Q11, zero or negative.
+ */
+static int32_t ln_humidity(Percent humi)
+{
+    uint16_t x = humi.raw;
+    int32_t log2_q14;
+    uint8_t e = 15;
+
+    if (x < HUMI_MIN_Q8)
+        x = HUMI_MIN_Q8;
+    if (x > HUMI_MAX_Q8)
+        x = HUMI_MAX_Q8;
+
+    /* x = 1.m * 2^e */
+    while (!(x & 0x8000)) {
+        x <<= 1;
+        e--;
+    }
+    log2_q14 = ((int32_t)e << 14) +
+               interpolate(tables.log2, x - 0x8000, LOG2_SHIFT, LOG2_POINTS);
+
+    return ((log2_q14 - LOG2_HUMI_MAX_Q14) * LN2_Q14) >> 17;
+}
+
+/**
+ * @brief  Dew point: Td = b.gamma / (a - gamma), gamma = ln(RH) + a.T / (b + T).
+ * @param  temp: air temperature.
+ *         humi: relative humidity.
+ *
+ * @retval Dew point, within 0.04oC of the formula.
+ */
+Celsius Comfort::dew_point(Celsius temp, Percent humi)
+{
+    int32_t gamma;
+
+    gamma = ln_humidity(humi) +
+            interpolate(tables.gamma, (int32_t)temp.raw - T_MIN_Q8, T_SHIFT, T_POINTS);
+
+    return Celsius::from_raw(interpolate(tables.dew_point, gamma - GAMMA_MIN_Q11,
+                                         GAMMA_SHIFT, GAMMA_POINTS));
+}
+
+/**
+ * @brief  Absolute humidity: water vapour mass per volume of air.
+ * @param  temp: air temperature.
+ *         humi: relative humidity, clamped to 100%.
+ *
+ * @retval g/m3.
+ */
+GramsPerM3 Comfort::absolute_humidity(Celsius temp, Percent humi)
+{
+    uint32_t k;
+
+    k = interpolate(tables.vapour, (int32_t)temp.raw - T_MIN_Q8, T_SHIFT, T_POINTS);
+    if (humi.raw > HUMI_MAX_Q8)
+        humi.raw = HUMI_MAX_Q8;
+
+    return GramsPerM3::from_raw(FixedTraits<uint16_t>::saturate((k * humi.raw) >> 14));
+}
+
+/**
+ * @brief  Heat index (apparent temperature), NWS method without the
+ *         low/high humidity adjustments, blended across the switch to
+ *         the regression. Evaluated in Q16 with the regression as
+ *         polynomials of T: A(T) + B(T).RH + C(T).RH^2.
+ * @param  temp: air temperature, clamped to 50oC.
+ *         humi: relative humidity, clamped to 100%.
+ *
+ * @retval Heat index.
+ */
+Celsius Comfort::heat_index(Celsius temp, Percent humi)
+{
+    static constexpr int32_t s0 = comfort_round(HI_S0 * 65536);
+    static constexpr int32_t s1 = comfort_round(HI_S1 * 65536);
+    static constexpr int32_t s2 = comfort_round(HI_S2 * 65536);
+    static constexpr int32_t blend_lo = comfort_round(HI_THRESHOLD * 65536) - HI_BLEND_Q16 / 2;
+    /* A: Q16, B: Q20, C: Q26 */
+    static constexpr int32_t a0 = comfort_round(HI_C1 * 65536);
+    static constexpr int32_t a1 = comfort_round(HI_C2 * 65536);
+    static constexpr int32_t a2 = comfort_round(HI_C5 * 65536);
+    static constexpr int32_t b0 = comfort_round(HI_C3 * 1048576);
+    static constexpr int32_t b1 = comfort_round(HI_C4 * 1048576);
+    static constexpr int32_t b2 = comfort_round(HI_C7 * 1048576);
+    static constexpr int32_t c0 = comfort_round(HI_C6 * 67108864);
+    static constexpr int32_t c1 = comfort_round(HI_C8 * 67108864);
+    static constexpr int32_t c2 = comfort_round(HI_C9 * 67108864);
+
+    int32_t t = temp.raw;
+    int32_t rh = humi.raw;
+    int32_t a, b, c, hi, w;
+
+    if (t > HI_T_MAX_Q8)
+        t = HI_T_MAX_Q8;
+    if (rh > HUMI_MAX_Q8)
+        rh = HUMI_MAX_Q8;
+
+    /* Q16 */
+    hi = s0 + ((s1 * t) >> 8) + ((s2 * rh) >> 8);
+
+    /* Weight of the regression, Q8: 0 below the band, 256 above */
+    w = (hi + t * 256 - blend_lo) >> 8;
+
+    if (w > 0) {
+        a = a0 + (((a1 + ((a2 * t) >> 8)) * t) >> 8);
+        b = b0 + (((b1 + ((b2 * t) >> 8)) * t) >> 8);
+        c = c0 + (((c1 + ((c2 * t) >> 8)) * t) >> 8);
+
+        /* B.RH: Q16; C.RH^2: Q20, then Q14 */
+        c = ((c >> 6) * rh) >> 8;
+        c = ((c >> 6) * rh) >> 8;
+        a = a + (((b >> 4) * rh) >> 8) + (c << 2);
+
+        if (w >= 256)
+            hi = a;
+        else
+            hi += ((a - hi) * w) >> 8;
+    }
+
+    return Celsius::from_raw(FixedTraits<int16_t>::saturate((hi + 128) >> 8));
+}
@@ -0,0 +1,41 @@
+/*
+ * Comfort.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Quantities derived from a temperature and humidity reading, in
+ *      fixed point (lib/fixed.h) with no float or division at run time:
+ *
+ *          dew_point()          Magnus formula (Sonntag 1990), over water
+ *          absolute_humidity()  ideal gas, Magnus vapour pressure
+ *          heat_index()         NWS: Steadman below 26.7oC, Rothfusz above,
+ *                               blended over 0.5oC around the switch
+ *
+ *      The exponentials and logarithms are interpolation tables built by
+ *      constexpr code at compile time (Comfort.cpp). The tables span
+ *      -40 to 80oC and 1 to 100 %RH; inputs outside are clamped. The error
+ *      against a double precision evaluation is printed by
+ *      th-comfort-bench (host/comfort).
+ */
+
+#ifndef COMFORT_H_
+#define COMFORT_H_
+
+#include <stdint.h>
+
+#include "lib/fixed.h"
+#include "HygroSensor.h"
+
+/* g/m3, Q8: saturates at 256 (100 %RH above ~77oC) */
+typedef Fixed<8, uint16_t> GramsPerM3;
+
+class Comfort
+{
+public:
+    static Celsius dew_point(Celsius temp, Percent humi);
+    static GramsPerM3 absolute_humidity(Celsius temp, Percent humi);
+    static Celsius heat_index(Celsius temp, Percent humi);
+};
+
+#endif /* COMFORT_H_ */
@@ -3,6 +3,14 @@
  *
  *  Created on: Jun 18, 2024
  *      Author: xtarke
+ *
+ *      The sensor may be supplied by an output pin PWR (high side switch)
+ *      so it draws nothing between readings: power_on(), at least
+ *      DHT22_POWER_UP_MS before the start signal, then power_off(). The
+ *      DQ pull-up must be on the switched supply: DQ is driven low while
+ *      the sensor is off, so it is not fed through the data line.
+ *
+ *          Dht22<DhtPin, Pin<Port2, BIT1> > sensor;
  */
 
 #ifndef DHT22_H_
@@ -11,19 +19,159 @@
 #include <stdint.h>
 
 #include "OneWire.h"
+#include "HygroSensor.h"
+
+/* Unstable after power-up: no start signal before */
+#define DHT22_POWER_UP_MS   1000
+
+/* After the last bit the sensor holds the line low ~50us and releases
+ * it for good: watched for >100us, longer than any '1' (75us max) */
+#define DHT22_IDLE_LOOPS    (cycles_for_us(100) / 6)
+
+/* dht_response() results: cause of a failed read */
+enum {
+    DHT22_OK,
+    DHT22_NO_RESPONSE,      /* no response pulse: sensor missing */
+    DHT22_NO_RELEASE,       /* line held low after the response */
+    DHT22_TIMEOUT,          /* edge lost or extra edge inside the frame */
+    DHT22_CHECKSUM,         /* whole frame received, checksum mismatch */
+    DHT22_RESULTS
+};
 
-class Dht22: public OneWire
+template <class DQ, class PWR = NoPin>
+class Dht22: public OneWire<DQ>, public HygroSensor
 {
 public:
-    Dht22();
-
     uint8_t dht_response();
-    uint16_t get_temp();
-    uint16_t get_humid();
+    uint8_t read() { return dht_response() == DHT22_OK; }
+
+    /* Supply switch, no-ops without PWR */
+    void power_on();
+    void power_off();
 
 private:
+    uint8_t frame_end();
+
     uint8_t dht11_data[4];
 
 };
 
+/**
+ * @brief  Start signal and 40-bit frame. Values are updated only when
+ *         the checksum matches.
+ * @param  Nenhum
+ *
+ * @retval DHT22_OK or failure cause.
+ */
+template <class DQ, class PWR>
+uint8_t Dht22<DQ, PWR>::dht_response() {
+
+    uint8_t i;
+    uint8_t sum = 0;
+    uint8_t checksum;
+
+    switch (this->reset_1w()) {
+    case ONE_WIRE_NO_RESPONSE:
+        return DHT22_NO_RESPONSE;
+    case ONE_WIRE_NO_RELEASE:
+        return DHT22_NO_RELEASE;
+    }
+
+    for(i=0; i < 4; i++) {
+        dht11_data[i]  = this->read_byte_1w();
+        sum += dht11_data[i];
+    }
+    checksum = this->read_byte_1w();
+
+    /* A glitch read as a bit ends the frame early, with the sensor still
+     * sending: a timing failure, not a checksum one */
+    if (this->timeout_1w() || !frame_end())
+        return DHT22_TIMEOUT;
+
+    if (sum != checksum)
+        return DHT22_CHECKSUM;
+
+    humidity = dht11_data[0] << 8 | dht11_data[1];
+    /* Temperature is sign and magnitude: bit 15 is the sign */
+    temperature = (dht11_data[2] & 0x7F) << 8 | dht11_data[3];
+    if (dht11_data[2] & 0x80)
+        temperature = -temperature;
+
+    return DHT22_OK;
+}
+
+/**
+ * @brief  End of frame: the end pulse, then the line released with no
+ *         edge for DHT22_IDLE_LOOPS polls. Interrupts are disabled
+ *         meanwhile: a pulse could pass unseen during an ISR.
+ * @param  Nenhum
+ *
+ * @retval 1 at the end of the frame, 0 if the sensor is still sending.
+ */
+template <class DQ, class PWR>
+uint8_t Dht22<DQ, PWR>::frame_end()
+{
+    uint16_t loops = ONE_WIRE_EDGE_LOOPS;
+    uint16_t sr = __get_SR_register();
+    uint8_t idle = 0;
+
+    __disable_interrupt();
+
+    while (!DQ::read()) {
+        if (!--loops)
+            break;
+    }
+
+    if (loops) {
+        loops = DHT22_IDLE_LOOPS;
+        while (DQ::read()) {
+            if (!--loops) {
+                idle = 1;
+                break;
+            }
+        }
+    }
+
+    if (sr & GIE)
+        __enable_interrupt();
+
+    return idle;
+}
+
+/**
+ * @brief  Supply the sensor and release DQ to its pull-up. No start
+ *         signal for DHT22_POWER_UP_MS.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+template <class DQ, class PWR>
+void Dht22<DQ, PWR>::power_on()
+{
+    if (!PWR::mask)
+        return;
+
+    PWR::set();
+    PWR::output();
+    DQ::input();
+}
+
+/**
+ * @brief  Cut the sensor supply and hold DQ low.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+template <class DQ, class PWR>
+void Dht22<DQ, PWR>::power_off()
+{
+    if (!PWR::mask)
+        return;
+
+    PWR::clear();
+    PWR::output();
+    DQ::clear();
+    DQ::output();
+}
+
 #endif /* DHT22_H_ */
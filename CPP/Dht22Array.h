@@ -0,0 +1,189 @@
+/*
+ * Dht22Array.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Up to eight DHT22 sensors, one per pin of the LANES port mask,
+ *      triggered at the same time and decoded in a single frame.
+ *
+ *      Bit-parallel DHT22 decoder: the whole PxIN byte is sampled at a
+ *      fixed rate and each pin is handled as an independent lane. Sensors
+ *      drift apart during a frame (a '1' is ~45 us longer than a '0'), so
+ *      every lane keeps its own bit position, but the high-time measurement
+ *      of all lanes is done at once with bit-sliced counters.
+ *
+ *      The sample count is the time base of every lane, so interrupts
+ *      are off from the release of the start signal to the end of the
+ *      frame (~5.6ms), restored to the caller's GIE after it. Dht22 runs
+ *      pending ISRs between bits instead: a UART at 115200 baud may
+ *      overrun during an array read.
+ *
+ *          Dht22Array<Pin<Port2, BIT0 | BIT1 | BIT2> > zones;
+ */
+
+#ifndef DHT22ARRAY_H_
+#define DHT22ARRAY_H_
+
+#include <msp430.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib/pin.h"
+#include "lib/clock.h"
+
+/* Maximum number of sensors: one per port pin */
+#define DHT22_ARRAY_MAX         8
+/* Bytes per DHT22 frame: humidity (2), temperature (2), checksum */
+#define DHT22_FRAME_SIZE        5
+
+template <class LANES>
+class Dht22Array
+{
+public:
+    uint8_t dht_response();
+    int16_t get_temp(uint8_t n);
+    uint16_t get_humid(uint8_t n);
+
+private:
+    uint8_t frames[DHT22_ARRAY_MAX][DHT22_FRAME_SIZE];
+
+};
+
+/* Sampling loop period: ~12us including ~2us of loop body at 16MHz.
+ * 4 samples (~48us) is the midpoint between a 0 (28us) and a 1 (70us) */
+#define DHT22_ARRAY_SAMPLE_US   10
+/* The loop body alone takes ~32us at 1MHz */
+#if F_CPU < 8000000UL
+    #error "Dht22Array needs F_CPU >= 8MHz"
+#endif
+/* Sensors answer 20 to 200us after the start signal: a lane is present
+ * if it pulls its line low within this window */
+#define DHT22_ARRAY_RESPONSE_US 250
+#define DHT22_ARRAY_RESPONSE_SAMPLES (DHT22_ARRAY_RESPONSE_US / DHT22_ARRAY_SAMPLE_US)
+/* 40 bits of at most 130us plus the response: ~5.6ms, ~470 samples at
+ * 16MHz. The limit bounds a read with a lost lane to ~10ms */
+#define DHT22_ARRAY_MAX_SAMPLES 800
+/* 40 data bits per frame */
+#define DHT22_FRAME_BITS        (DHT22_FRAME_SIZE * 8)
+
+/**
+ * @brief  Trigger every sensor in pin mask and decode all frames.
+ * @param  Nenhum
+ *
+ * @retval Mask of lanes with a valid checksum.
+ */
+template <class LANES>
+uint8_t Dht22Array<LANES>::dht_response()
+{
+    uint8_t i;
+    uint8_t lane;
+    uint8_t present = 0;
+    uint8_t valid = 0;
+    uint8_t done = 0;
+    uint8_t prev, now, fall;
+    /* Bit-sliced saturating counters: bit n of c0..c2 is the 3-bit
+     * high-time counter of lane n (units of one sample period) */
+    uint8_t c0 = 0, c1 = 0, c2 = 0;
+    uint8_t inc, t0, t1;
+    /* Per lane bit position. -1: first falling edge ends the 80us
+     * response pulse and carries no data. */
+    int8_t bit_pos[DHT22_ARRAY_MAX];
+    uint16_t samples;
+    uint16_t sr = __get_SR_register();
+
+    memset(frames, 0, sizeof(frames));
+    memset(bit_pos, -1, sizeof(bit_pos));
+
+    /* Start signal on all lanes: >1ms low */
+    LANES::output();
+    LANES::clear();
+    delay_us<1100>();
+
+    /* The sample period is the bit clock: no ISR until the frame ends */
+    __disable_interrupt();
+    LANES::input();
+
+    prev = 0;
+
+    for (samples = 0; samples < DHT22_ARRAY_MAX_SAMPLES &&
+                      (samples < DHT22_ARRAY_RESPONSE_SAMPLES || done != present); samples++) {
+        now = LANES::port::in() & LANES::mask;
+
+        /* Each sensor answers after its own delay: a lane joins when its
+         * response pulse starts, so its first fall ends that pulse */
+        if (samples < DHT22_ARRAY_RESPONSE_SAMPLES)
+            present |= ~now & LANES::mask;
+        now &= present;
+
+        /* Increment the counters of all high lanes at once, saturating at 7 */
+        inc = now & ~(c0 & c1 & c2);
+        t0 = inc & c0;
+        t1 = t0 & c1;
+        c2 ^= t1;
+        c1 ^= t0;
+        c0 ^= inc;
+
+        fall = prev & ~now & ~done;
+
+        if (fall) {
+            /* Decision for every falling lane: high for 4 or more samples
+             * (~48us) is a '1', 26-28us is a '0'. c2 holds exactly that. */
+            for (i = 0, lane = 1; i < DHT22_ARRAY_MAX; i++, lane <<= 1) {
+                if (!(fall & lane))
+                    continue;
+
+                if (bit_pos[i] >= 0 && (c2 & lane))
+                    frames[i][bit_pos[i] >> 3] |= 0x80 >> (bit_pos[i] & 7);
+
+                if (++bit_pos[i] == DHT22_FRAME_BITS)
+                    done |= lane;
+            }
+            c0 &= ~fall;
+            c1 &= ~fall;
+            c2 &= ~fall;
+        }
+
+        prev = now;
+        delay_us<DHT22_ARRAY_SAMPLE_US>();
+    }
+
+    if (sr & GIE)
+        __enable_interrupt();
+
+    for (i = 0, lane = 1; i < DHT22_ARRAY_MAX; i++, lane <<= 1) {
+        uint8_t sum = frames[i][0] + frames[i][1] + frames[i][2] + frames[i][3];
+
+        if ((done & lane) && sum == frames[i][4])
+            valid |= lane;
+    }
+
+    return valid;
+}
+
+/**
+ * @brief  Temperature of a lane valid in the last dht_response().
+ * @param  n: lane, bit number of the pin.
+ *
+ * @retval Tenths of oC, as Dht22::get_temp().
+ */
+template <class LANES>
+int16_t Dht22Array<LANES>::get_temp(uint8_t n){
+    int16_t temp = (frames[n][2] & 0x7F) << 8 | frames[n][3];
+
+    /* Sign and magnitude: bit 15 is the sign */
+    return frames[n][2] & 0x80 ? -temp : temp;
+}
+
+/**
+ * @brief  Humidity of a lane valid in the last dht_response().
+ * @param  n: lane, bit number of the pin.
+ *
+ * @retval Tenths of %RH.
+ */
+template <class LANES>
+uint16_t Dht22Array<LANES>::get_humid(uint8_t n){
+    return frames[n][0] << 8 | frames[n][1];
+}
+
+#endif /* DHT22ARRAY_H_ */
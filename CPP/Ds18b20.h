@@ -0,0 +1,152 @@
+/*
+ * Ds18b20.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Several DS18B20 probes on one 1-Wire pin. update() issues a single
+ *      Convert T to all devices (skip ROM), sleeps once for the 750ms
+ *      12-bit conversion and then reads each scratchpad by ROM code, so
+ *      the conversion time does not grow with the number of probes.
+ *
+ *          typedef Pin<Port2, BIT1> ProbePin;
+ *          Ds18b20<ProbePin> probes;
+ *
+ *          probes.scan();
+ *          valid = probes.update();
+ */
+
+#ifndef DS18B20_H_
+#define DS18B20_H_
+
+#include <stdint.h>
+
+#include "OneWireBus.h"
+#include "lib/crc.h"
+#include "lib/timer_delay.h"
+
+#define DS18B20_FAMILY_CODE         0x28
+#define DS18B20_MAX_DEVICES         4
+
+/* Function commands */
+#define DS18B20_CONVERT_T           0x44
+#define DS18B20_READ_SCRATCHPAD     0xBE
+#define DS18B20_SCRATCHPAD_SIZE     9
+
+/* 12-bit resolution conversion time */
+#define DS18B20_CONVERSION_MS       750
+
+template <class DQ>
+class Ds18b20: public OneWireBus<DQ>
+{
+public:
+    Ds18b20();
+
+    uint8_t scan();
+    uint8_t update();
+    uint8_t get_count();
+    int16_t get_temp(uint8_t n);
+
+private:
+    uint8_t roms[DS18B20_MAX_DEVICES][ONE_WIRE_ROM_SIZE];
+    int16_t temps[DS18B20_MAX_DEVICES];
+    uint8_t count;
+};
+
+template <class DQ>
+Ds18b20<DQ>::Ds18b20()
+{
+    count = 0;
+}
+
+/**
+ * @brief  Search the bus and keep the ROM code of every DS18B20 found.
+ * @param  Nenhum
+ *
+ * @retval Number of probes.
+ */
+template <class DQ>
+uint8_t Ds18b20<DQ>::scan()
+{
+    uint8_t rom[ONE_WIRE_ROM_SIZE];
+
+    count = 0;
+    this->reset_search();
+
+    while (count < DS18B20_MAX_DEVICES && this->search_rom(rom)) {
+        if (rom[0] == DS18B20_FAMILY_CODE) {
+            memcpy(roms[count], rom, ONE_WIRE_ROM_SIZE);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief  Convert T on all probes at once, then read each one.
+ *         CPU stays in LPM0 during the conversion.
+ * @param  Nenhum
+ *
+ * @retval Mask of probes with a valid scratchpad CRC.
+ */
+template <class DQ>
+uint8_t Ds18b20<DQ>::update()
+{
+    uint8_t n, i;
+    uint8_t valid = 0;
+    uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+    int16_t raw;
+
+    if (!count || !this->reset())
+        return 0;
+
+    this->skip_rom();
+    this->write_byte(DS18B20_CONVERT_T);
+
+    /* Parasite powered probes need a strong pull-up while converting */
+    this->strong_pull_up();
+    timer_delay_ms(DS18B20_CONVERSION_MS);
+    this->release();
+
+    for (n=0; n < count; n++) {
+        if (!this->reset())
+            break;
+
+        this->match_rom(roms[n]);
+        this->write_byte(DS18B20_READ_SCRATCHPAD);
+
+        for (i=0; i < DS18B20_SCRATCHPAD_SIZE; i++)
+            scratchpad[i] = this->read_byte();
+
+        if (crc8_maxim(scratchpad, DS18B20_SCRATCHPAD_SIZE))
+            continue;
+
+        /* 1/16 oC -> 1/10 oC: raw * 10 / 16 */
+        raw = (int16_t)(scratchpad[1] << 8 | scratchpad[0]);
+        temps[n] = (raw * 5) >> 3;
+        valid |= 1 << n;
+    }
+
+    return valid;
+}
+
+template <class DQ>
+uint8_t Ds18b20<DQ>::get_count()
+{
+    return count;
+}
+
+/**
+ * @brief  Last temperature of probe n.
+ * @param  n: probe index, in scan() order.
+ *
+ * @retval Temperature in tenths of oC.
+ */
+template <class DQ>
+int16_t Ds18b20<DQ>::get_temp(uint8_t n)
+{
+    return temps[n];
+}
+
+#endif /* DS18B20_H_ */
@@ -0,0 +1,70 @@
+/*
+ * Hdc1080.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <lib/i2c_master_f247_g2xxx.h>
+#include <lib/timer_delay.h>
+
+#include "Hdc1080.h"
+
+Hdc1080::Hdc1080(uint8_t i2c_addr)
+{
+    my_i2c_addr = i2c_addr;
+}
+
+/**
+ * @brief  Check device ID and select sequential acquisition.
+ *         Call after I2C initialization.
+ * @param  Nenhum
+ *
+ * @retval 1 if the sensor was found.
+ */
+uint8_t Hdc1080::init()
+{
+    uint8_t id[2];
+    uint8_t config[2] = { HDC1080_CONFIG_MODE_SEQ, 0x00 };
+
+    if (i2c_master_read_reg(my_i2c_addr, HDC1080_REG_DEVICE_ID, sizeof(id), id) != IDLE_MODE)
+        return 0;
+
+    if ((id[0] << 8 | id[1]) != HDC1080_DEVICE_ID)
+        return 0;
+
+    return i2c_master_write_reg(my_i2c_addr, HDC1080_REG_CONFIG, config, sizeof(config)) == IDLE_MODE;
+}
+
+/**
+ * @brief  Trigger a measurement and read both results.
+ * @param  Nenhum
+ *
+ * @retval 1 if the reading is valid.
+ */
+uint8_t Hdc1080::read()
+{
+    /* T msb, T lsb, RH msb, RH lsb */
+    uint8_t data[4];
+    uint16_t raw;
+
+    /* Pointer write to the temperature register triggers the measurement */
+    if (i2c_write_single_byte(my_i2c_addr, HDC1080_REG_TEMPERATURE) != IDLE_MODE)
+        return 0;
+
+    timer_delay_ms(HDC1080_MEASUREMENT_MS);
+
+    /* Data must be read without a new pointer write */
+    if (i2c_master_read(my_i2c_addr, sizeof(data), data) != IDLE_MODE)
+        return 0;
+
+    /* T = 165 * raw / 2^16 - 40 : tenths of oC, rounded */
+    raw = data[0] << 8 | data[1];
+    temperature = (int16_t)(((uint32_t)raw * 1650 + 0x8000) >> 16) - 400;
+
+    /* RH = 100 * raw / 2^16 : tenths of % */
+    raw = data[2] << 8 | data[3];
+    humidity = ((uint32_t)raw * 1000 + 0x8000) >> 16;
+
+    return 1;
+}
@@ -0,0 +1,45 @@
+/*
+ * Hdc1080.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      TI HDC1080 humidity sensor: temperature and humidity acquired in
+ *      sequence (14-bit) by one trigger. CPU sleeps in LPM0 during the
+ *      conversion.
+ */
+
+#ifndef HDC1080_H_
+#define HDC1080_H_
+
+#include <stdint.h>
+
+#include "HygroSensor.h"
+
+#define HDC1080_I2C_ADDRESS         0x40
+
+/* Registers */
+#define HDC1080_REG_TEMPERATURE     0x00
+#define HDC1080_REG_CONFIG          0x02
+#define HDC1080_REG_DEVICE_ID       0xFF
+
+#define HDC1080_DEVICE_ID           0x1050
+/* Config: acquire temperature and humidity in sequence, 14-bit */
+#define HDC1080_CONFIG_MODE_SEQ     0x10
+
+/* 6.35ms (T) + 6.5ms (RH) */
+#define HDC1080_MEASUREMENT_MS      15
+
+class Hdc1080: public HygroSensor
+{
+public:
+    Hdc1080(uint8_t i2c_addr);
+
+    uint8_t init();
+    uint8_t read();
+
+private:
+    uint8_t my_i2c_addr;
+};
+
+#endif /* HDC1080_H_ */
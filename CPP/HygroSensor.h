@@ -0,0 +1,43 @@
+/*
+ * HygroSensor.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Common interface of the temperature/humidity sensors (DHT22,
+ *      SHT3x, HDC1080, BME280) so the application does not depend on
+ *      which one is fitted.
+ */
+
+#ifndef HYGROSENSOR_H_
+#define HYGROSENSOR_H_
+
+#include <stdint.h>
+
+#include "lib/fixed.h"
+
+/* Q8: input of the derived quantities (dew point...) */
+typedef Fixed<8> Celsius;
+typedef Fixed<8, uint16_t> Percent;
+
+class HygroSensor
+{
+public:
+    /* Start a measurement and wait for it: 1 if the reading is valid */
+    virtual uint8_t read() = 0;
+
+    /* Last valid reading: tenths of oC */
+    int16_t get_temp() { return temperature; }
+    /* Last valid reading: tenths of %RH */
+    uint16_t get_humid() { return humidity; }
+
+    /* Last valid reading in fixed point */
+    Celsius get_celsius() { return Celsius::from_scaled<10>(temperature); }
+    Percent get_percent() { return Percent::from_scaled<10>(humidity); }
+
+protected:
+    int16_t temperature;
+    uint16_t humidity;
+};
+
+#endif /* HYGROSENSOR_H_ */
@@ -0,0 +1,98 @@
+/*
+ * LagEstimator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include "LagEstimator.h"
+
+/* Gain table entries, one per tick since the last reading */
+#define LAG_GAIN_TICKS          32
+
+/* a / (1 - a) in Q8 with a = decay^ticks in Q15, for ticks 1 to
+ * LAG_GAIN_TICKS: the division is left to the compiler */
+struct LagGainTable {
+    uint16_t gain[LAG_GAIN_TICKS + 1];
+
+    constexpr LagGainTable() : gain()
+    {
+        uint32_t decay = LAG_DECAY_Q15;
+
+        for (int i = 1; i <= LAG_GAIN_TICKS; i++) {
+            if (i > 1)
+                decay = (decay * LAG_DECAY_Q15) >> 15;
+            gain[i] = (uint16_t)((decay << 8) / (32768U - decay));
+        }
+    }
+};
+
+/* Flash: built by the compiler, no initialization code */
+static constexpr LagGainTable gains;
+
+static_assert(gains.gain[LAG_GAIN_TICKS] == 0, "gain left at the last tick of the table");
+
+LagEstimator::LagEstimator()
+{
+    reset();
+}
+
+/**
+ * @brief  Forget the previous reading: a failed read breaks the series.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void LagEstimator::reset()
+{
+    have_last = 0;
+    estimated = 0;
+    last = 0;
+    estimate = 0;
+}
+
+/**
+ * @brief  New reading: settled value projected from the last two.
+ * @param  value: reading, tenths.
+ * @param  elapsed: ticks since the previous reading.
+ *
+ * @retval Estimate, or the reading itself when the change is too small
+ *         or the readings too far apart to project.
+ */
+uint16_t LagEstimator::update(uint16_t value, uint16_t elapsed)
+{
+    uint16_t gain;
+    int32_t delta;
+    int32_t x;
+
+    delta = (int32_t)value - last;
+    estimated = 0;
+    estimate = value;
+
+    if (!have_last || !elapsed) {
+        have_last = 1;
+        last = value;
+
+        return estimate;
+    }
+    last = value;
+
+    if (delta < LAG_MIN_STEP && delta > -LAG_MIN_STEP)
+        return estimate;
+
+    /* a / (1 - a), Q8: zero from the end of the table */
+    gain = elapsed <= LAG_GAIN_TICKS ? gains.gain[elapsed] : 0;
+    if (!gain)
+        return estimate;
+
+    x = value + ((delta * gain) >> 8);
+    if (x < 0)
+        x = 0;
+    if (x > LAG_MAX_VALUE)
+        x = LAG_MAX_VALUE;
+
+    estimated = 1;
+    estimate = (uint16_t)x;
+
+    return estimate;
+}
@@ -0,0 +1,58 @@
+/*
+ * LagEstimator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Settled value of a sensor that follows its input as a first order
+ *      lag, from its last two readings. With a = exp(-t/tau) between the
+ *      readings y0 and y1 the input x is
+ *
+ *          x = y1 + (y1 - y0) * a / (1 - a)
+ *
+ *      The gain a / (1 - a) is a table per number of watchdog ticks, built
+ *      at compile time from the decay of one tick. It fades out as the readings get further apart,
+ *      and small changes (sensor noise) are not projected at all.
+ *
+ *          humi = lag.update(reading, ticks_since_last);
+ *          if (lag.is_estimated()) ...
+ */
+
+#ifndef LAGESTIMATOR_H_
+#define LAGESTIMATOR_H_
+
+#include <stdint.h>
+
+/* exp(-tick / tau) in Q15: DHT22 humidity, tau ~8s, tick ~2.7s (VLO) */
+#ifndef LAG_DECAY_Q15
+#define LAG_DECAY_Q15           23295
+#endif
+
+/* Smallest change between two readings that is projected: tenths */
+#ifndef LAG_MIN_STEP
+#define LAG_MIN_STEP            5
+#endif
+
+/* Upper bound of the estimate: tenths (100.0 %RH) */
+#ifndef LAG_MAX_VALUE
+#define LAG_MAX_VALUE           1000
+#endif
+
+class LagEstimator
+{
+public:
+    LagEstimator();
+
+    uint16_t update(uint16_t value, uint16_t elapsed);
+    void reset();
+    uint8_t is_estimated() { return estimated; }
+    uint16_t get_value() { return estimate; }
+
+private:
+    uint8_t have_last;
+    uint8_t estimated;
+    uint16_t last;
+    uint16_t estimate;
+};
+
+#endif /* LAGESTIMATOR_H_ */
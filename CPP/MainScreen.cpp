@@ -0,0 +1,202 @@
+/*
+ * MainScreen.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <lib/format.h>
+
+#include "MainScreen.h"
+
+/* Three digit fields of the comfort band: 99.9 */
+#define COMFORT_MAX_TENTHS  999
+
+/* Three digit temperature field: -99.9 to 99.9 */
+#define TEMP_MAX_TENTHS     999
+
+MainScreen::MainScreen(SSD1306 &display) :
+    oled(display)
+{
+    shown_dew_point = 0;
+    shown_value = 0;
+    shown_comfort = 0;
+}
+
+/**
+ * @brief  Blank the comfort band: at start-up, and when there is no valid
+ *         reading to derive it from. The others are written by every
+ *         show(): blanking them at start-up is redundant.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void MainScreen::clear_comfort()
+{
+    shown_comfort = 0;
+#ifdef OLED_FULL_FRAME
+    oled.ClearPages(SSD1306::LINE_2 & 0x07, 2);
+#else
+    oled.ClearFrameBuffer();
+    oled.Refresh(SSD1306::LINE_2);
+#endif
+}
+
+/**
+ * @brief  Send what was drawn: full frame, the changed pages are queued
+ *         and sent in the background (SSD1306::Flush()). Band mode:
+ *         nothing, each band was sent when drawn.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void MainScreen::send()
+{
+    oled.Flush();
+}
+
+/**
+ * @brief  Start drawing a band. Band mode: the frame buffer holds only
+ *         this band, drawn from its top. Full frame: drawn in place and
+ *         not cleared, the layout is fixed and redraws every character
+ *         cell, so only pixels that change make a page dirty.
+ * @param  line: band.
+ *
+ * @retval First row of the band in the frame buffer.
+ */
+int16_t MainScreen::begin_band(SSD1306::oled_partition_t line)
+{
+#ifdef OLED_FULL_FRAME
+    return (line & 0x07) * OLED_PAGE_HEIGHT_PX;
+#else
+    (void)line;
+    oled.ClearFrameBuffer();
+    return 0;
+#endif
+}
+
+void MainScreen::end_band(SSD1306::oled_partition_t line)
+{
+#ifdef OLED_FULL_FRAME
+    (void)line;
+#else
+    oled.Refresh(line);
+#endif
+}
+
+/**
+ * @brief  Draw the three bands of the main screen, sent as drawn in band
+ *         mode, by send() in full frame.
+ * @param  temp: temperature, tenths of oC, clipped to +-99.9. Below
+ *               0oC the sign takes the leading 0, or the colon from
+ *               -10.0oC: "T: -5.3", "T-12.3".
+ *         humi: humidity, tenths of %RH.
+ *         voltage: battery, tenths of V.
+ *         humi_estimated: humidity is a projected value, drawn as h~.
+ *
+ * @retval Nenhum.
+ */
+void MainScreen::show(int16_t temp, uint16_t humi, uint16_t voltage,
+                      uint8_t humi_estimated)
+{
+    uint8_t digits[3];
+    uint8_t negative;
+    int16_t y;
+
+    if (temp > TEMP_MAX_TENTHS)
+        temp = TEMP_MAX_TENTHS;
+    if (temp < -TEMP_MAX_TENTHS)
+        temp = -TEMP_MAX_TENTHS;
+    negative = format_digits_signed(temp, digits, 3);
+    y = begin_band(SSD1306::LINE_1);
+    oled.WriteScaledChar(0, y, 'T', 2);
+    oled.WriteScaledChar(16,y, negative && digits[0] ? '-' : ':',2);
+    oled.WriteScaledChar(32,y, negative && !digits[0] ? '-' : '0' + digits[0] ,2);
+    oled.WriteScaledChar(48,y, '0' + digits[1] ,2);
+    oled.WriteScaledChar(64,y, '.' ,2);
+    oled.WriteScaledChar(80,y, '0' + digits[2] ,2);
+    oled.WriteScaledChar(96,y, 'o',1);
+    oled.WriteScaledChar(104,y, 'C',2);
+    end_band(SSD1306::LINE_1);
+
+    format_digits(humi, digits, 3);
+
+    y = begin_band(SSD1306::LINE_3);
+    oled.WriteScaledChar(0, y, 'h',2);
+    oled.WriteScaledChar(16,y, humi_estimated ? '~' : ':',2);
+    oled.WriteScaledChar(32,y, '0' + digits[0] ,2);
+    oled.WriteScaledChar(48,y, '0' + digits[1] ,2);
+    oled.WriteScaledChar(64,y, '.', 2);
+    oled.WriteScaledChar(80,y, '0' + digits[2] ,2);
+    oled.WriteScaledChar(96,y, '%', 2);
+    end_band(SSD1306::LINE_3);
+
+    format_digits(voltage, digits, 2);
+    y = begin_band(SSD1306::LINE_4);
+    oled.WriteScaledChar(40, y + 8, 'b',1);
+    oled.WriteScaledChar(48, y + 8, ':',1);
+    oled.WriteScaledChar(56, y + 8, '0' + digits[0],1);
+    oled.WriteScaledChar(64, y + 8, '.',1);
+    oled.WriteScaledChar(72, y + 8, '0' + digits[1],1);
+    oled.WriteScaledChar(80, y + 8, 'V',1);
+    end_band(SSD1306::LINE_4);
+}
+
+/**
+ * @brief  Draw the comfort band: dew point and, on the right,
+ *         absolute humidity or, when it is hot, heat index. A band is
+ *         ~256 I2C bytes: not sent again when the values are unchanged.
+ * @param  dew_point: tenths of oC, may be negative.
+ *         value: tenths of g/m3, or tenths of oC with heat_index.
+ *         heat_index: value is the heat index, drawn as HI.
+ *
+ * @retval Nenhum.
+ */
+void MainScreen::show_comfort(int16_t dew_point, uint16_t value, uint8_t heat_index)
+{
+    uint8_t comfort = COMFORT_SHOWN | (heat_index ? COMFORT_HEAT_INDEX : 0);
+    int16_t y;
+
+    if (comfort == shown_comfort && dew_point == shown_dew_point && value == shown_value)
+        return;
+
+    shown_comfort = comfort;
+    shown_dew_point = dew_point;
+    shown_value = value;
+
+    y = begin_band(SSD1306::LINE_2) + 4;
+    oled.WriteScaledChar(0, y, 'T', 1);
+    oled.WriteScaledChar(8, y, 'd', 1);
+    write_tenths(16, y, dew_point);
+    oled.WriteScaledChar(72, y, heat_index ? 'H' : 'A', 1);
+    oled.WriteScaledChar(80, y, heat_index ? 'I' : 'H', 1);
+    write_tenths(88, y, (int16_t)(value > COMFORT_MAX_TENTHS ? COMFORT_MAX_TENTHS : value));
+    end_band(SSD1306::LINE_2);
+}
+
+/**
+ * @brief  Sign and three digits with a decimal point, small characters,
+ *         leading zero blanked: " 9.5", "-12.3". Clipped to +-99.9.
+ * @param  x: first column, five characters wide.
+ *         y: top row.
+ *         value: tenths.
+ *
+ * @retval Nenhum.
+ */
+void MainScreen::write_tenths(int16_t x, int16_t y, int16_t value)
+{
+    uint8_t digits[3];
+    uint8_t negative;
+
+    if (value > COMFORT_MAX_TENTHS)
+        value = COMFORT_MAX_TENTHS;
+    if (value < -COMFORT_MAX_TENTHS)
+        value = -COMFORT_MAX_TENTHS;
+    negative = format_digits_signed(value, digits, 3);
+
+    oled.WriteScaledChar(x, y, negative ? '-' : ' ', 1);
+    oled.WriteScaledChar(x + 8, y, digits[0] ? '0' + digits[0] : ' ', 1);
+    oled.WriteScaledChar(x + 16, y, '0' + digits[1], 1);
+    oled.WriteScaledChar(x + 24, y, '.', 1);
+    oled.WriteScaledChar(x + 32, y, '0' + digits[2], 1);
+}
@@ -0,0 +1,49 @@
+/*
+ * MainScreen.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Temperature, humidity and battery screen of the thermo hygrometer,
+ *      drawn band by band so it fits the G2553 frame buffer. The second
+ *      band holds the comfort line (Comfort.h) in small characters. With
+ *      a full frame buffer (OLED_FULL_FRAME) the bands are drawn in place
+ *      and send() queues the changed pages.
+ */
+
+#ifndef MAINSCREEN_H_
+#define MAINSCREEN_H_
+
+#include <stdint.h>
+
+#include "SSD1306.h"
+
+/* shown_comfort */
+#define COMFORT_SHOWN       0x01
+#define COMFORT_HEAT_INDEX  0x02
+
+class MainScreen
+{
+public:
+    MainScreen(SSD1306 &display);
+
+    void clear_comfort();
+    void show(int16_t temp, uint16_t humi, uint16_t voltage,
+              uint8_t humi_estimated = 0);
+    void show_comfort(int16_t dew_point, uint16_t value, uint8_t heat_index);
+    void send();
+
+private:
+    int16_t begin_band(SSD1306::oled_partition_t line);
+    void end_band(SSD1306::oled_partition_t line);
+    void write_tenths(int16_t x, int16_t y, int16_t value);
+
+    SSD1306 &oled;
+
+    /* Comfort band on the display, not sent again while unchanged */
+    int16_t shown_dew_point;
+    uint16_t shown_value;
+    uint8_t shown_comfort;
+};
+
+#endif /* MAINSCREEN_H_ */
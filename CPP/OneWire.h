@@ -3,24 +3,134 @@
  *
  *  Created on: Jun 18, 2024
  *      Author: Renan Augusto Starke
+ *
+ *      DHT22 single-wire handshake. Every wait for an edge is bounded, so
+ *      a missing sensor or a lost edge ends the read instead of hanging.
+ *
+ *      Each bit is sampled 48us after its rising edge, halfway between
+ *      the longest '0' (30us) and the shortest '1' (68us). Interrupts are
+ *      disabled from the wait for that edge to the sample: a WDT or USCI
+ *      ISR there would move the sample point and turn a '0' into a '1'.
+ *      They are enabled again for the rest of the bit, so pending ISRs
+ *      run between bits (at most ~105us off: the UART does not overrun).
  */
 
 #ifndef ONEWIRE_H_
 #define ONEWIRE_H_
 
+#include <msp430.h>
 #include <stdint.h>
 
-/* Hardware ports  */
-#define ONE_WIRE_PORT P2
-#define ONE_WIRE_PIN  BIT0
+#include "lib/pin.h"
+#include "lib/clock.h"
+
+/* Edge wait limit in polling iterations of at least 6 cycles: >750us,
+ * well over any DHT22 level (200us max for the response delay) */
+#define ONE_WIRE_EDGE_LOOPS     (cycles_for_us(750) / 6)
+
+/* reset_1w() results */
+#define ONE_WIRE_PRESENT        0
+#define ONE_WIRE_NO_RESPONSE    1   /* line never pulled low */
+#define ONE_WIRE_NO_RELEASE     2   /* response pulse never ended */
 
+template <class DQ>
 class OneWire
 {
 public:
-    OneWire();
-
     uint8_t reset_1w();
     uint8_t read_byte_1w();
+
+    /* An edge was lost by read_byte_1w() since reset_1w() */
+    uint8_t timeout_1w() { return timeout; }
+
+private:
+    uint8_t wait_level(uint8_t level);
+
+    uint8_t timeout;
 };
 
+/**
+ * @brief  Wait until DQ reaches level.
+ * @param  level: 0 or 1.
+ *
+ * @retval 1 on the edge, 0 after ONE_WIRE_EDGE_LOOPS polls.
+ */
+template <class DQ>
+inline uint8_t OneWire<DQ>::wait_level(uint8_t level)
+{
+    uint16_t loops = ONE_WIRE_EDGE_LOOPS;
+
+    while ((DQ::read() ? 1 : 0) != level) {
+        if (!--loops)
+            return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief  Start signal and sensor response. Returns at the falling edge
+ *         starting the first data bit.
+ * @param  Nenhum
+ *
+ * @retval ONE_WIRE_PRESENT or failure cause.
+ */
+template <class DQ>
+uint8_t OneWire<DQ>::reset_1w()
+{
+    timeout = 0;
+
+    DQ::output();
+    DQ::clear();
+    /* Start signal: >1ms low */
+    delay_us<1100>();
+
+    DQ::input();
+
+    /* Response: low 20-200us after the release, then 80us low and 80us
+     * high. Only the edges matter, no sampling: interrupts stay on */
+    if (!wait_level(0))
+        return ONE_WIRE_NO_RESPONSE;
+
+    if (!wait_level(1) || !wait_level(0))
+        return ONE_WIRE_NO_RELEASE;
+
+    return ONE_WIRE_PRESENT;
+}
+
+/**
+ * @brief  Read one wire byte. Call after reset_1w(): returns 0 without
+ *         touching the line once an edge was lost.
+ * @param  Nenhum
+ *
+ * @retval Byte read, MSB first.
+ */
+template <class DQ>
+uint8_t OneWire<DQ>::read_byte_1w()
+{
+    uint8_t i, dado = 0;
+    uint16_t sr = __get_SR_register();
+
+    for (i=0; i < 8 && !timeout; i++) {
+
+        __disable_interrupt();
+        if (!wait_level(1)) {
+            timeout = 1;
+        }
+        else {
+            delay_us<48>();
+
+            if (DQ::read())
+                dado |= (1 << (7-i));
+        }
+        if (sr & GIE)
+            __enable_interrupt();
+
+        if (!timeout && !wait_level(0))
+            timeout = 1;
+    }
+
+    return (dado);
+}
+
 #endif /* ONEWIRE_H_ */
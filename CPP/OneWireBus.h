@@ -0,0 +1,328 @@
+/*
+ * OneWireBus.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Maxim/Dallas 1-Wire master: reset/presence, read and write time
+ *      slots, ROM commands and ROM search (Maxim AN187), so several
+ *      devices can share one pin. OneWire only implements the DHT22
+ *      single-wire handshake.
+ *
+ *      Time slots are bit-banged with interrupts disabled: an ISR in the
+ *      middle of a 6us low pulse would turn it into a reset.
+ */
+
+#ifndef ONEWIREBUS_H_
+#define ONEWIREBUS_H_
+
+#include <msp430.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib/pin.h"
+#include "lib/crc.h"
+#include "lib/clock.h"
+
+/* 6us slots: the call and port overhead alone is ~10us at 1MHz */
+#if F_CPU < 8000000UL
+    #error "OneWireBus needs F_CPU >= 8MHz"
+#endif
+
+/* ROM commands */
+#define ONE_WIRE_SEARCH_ROM     0xF0
+#define ONE_WIRE_READ_ROM       0x33
+#define ONE_WIRE_MATCH_ROM      0x55
+#define ONE_WIRE_SKIP_ROM       0xCC
+
+#define ONE_WIRE_ROM_SIZE       8
+
+template <class DQ>
+class OneWireBus
+{
+public:
+    OneWireBus();
+
+    uint8_t reset();
+    void write_bit(uint8_t bit);
+    uint8_t read_bit();
+    void write_byte(uint8_t data);
+    uint8_t read_byte();
+
+    void skip_rom();
+    void match_rom(const uint8_t *rom);
+
+    void reset_search();
+    uint8_t search_rom(uint8_t *rom);
+
+    /* Drive the line high: power for parasite devices */
+    void strong_pull_up();
+    void release();
+
+private:
+    /* ROM search state */
+    uint8_t search_rom_no[ONE_WIRE_ROM_SIZE];
+    uint8_t last_discrepancy;
+    uint8_t last_device;
+};
+
+template <class DQ>
+OneWireBus<DQ>::OneWireBus()
+{
+    reset_search();
+}
+
+/**
+ * @brief  Reset pulse and presence detection.
+ * @param  Nenhum
+ *
+ * @retval 1 if at least one device answered, 0 otherwise.
+ */
+template <class DQ>
+uint8_t OneWireBus<DQ>::reset()
+{
+    uint8_t presence;
+    uint16_t sr = __get_SR_register();
+
+    DQ::clear();
+    DQ::output();
+    /* 480us reset pulse */
+    delay_us<480>();
+
+    __disable_interrupt();
+    DQ::input();
+    /* Presence pulse starts 15-60us after the release */
+    delay_us<70>();
+    /* Devices hold the line low */
+    presence = !DQ::read();
+    if (sr & GIE)
+        __enable_interrupt();
+
+    /* Remaining of 480us receive time */
+    delay_us<410>();
+
+    return presence;
+}
+
+/**
+ * @brief  Write time slot.
+ * @param  bit: 0 or 1.
+ *
+ * @retval Nenhum.
+ */
+template <class DQ>
+void OneWireBus<DQ>::write_bit(uint8_t bit)
+{
+    uint16_t sr = __get_SR_register();
+
+    __disable_interrupt();
+    DQ::clear();
+    DQ::output();
+
+    if (bit) {
+        /* 6us low, 64us recovery */
+        delay_us<6>();
+        DQ::input();
+        if (sr & GIE)
+            __enable_interrupt();
+        delay_us<64>();
+    }
+    else {
+        /* 60us low, 10us recovery */
+        delay_us<60>();
+        DQ::input();
+        if (sr & GIE)
+            __enable_interrupt();
+        delay_us<10>();
+    }
+}
+
+/**
+ * @brief  Read time slot.
+ * @param  Nenhum
+ *
+ * @retval Bit value.
+ */
+template <class DQ>
+uint8_t OneWireBus<DQ>::read_bit()
+{
+    uint8_t bit;
+    uint16_t sr = __get_SR_register();
+
+    __disable_interrupt();
+    DQ::clear();
+    DQ::output();
+    /* 6us low */
+    delay_us<6>();
+    DQ::input();
+    /* Sample 15us after slot start */
+    delay_us<9>();
+    bit = DQ::read() ? 1 : 0;
+    if (sr & GIE)
+        __enable_interrupt();
+
+    /* End of the 70us slot */
+    delay_us<55>();
+
+    return bit;
+}
+
+template <class DQ>
+void OneWireBus<DQ>::write_byte(uint8_t data)
+{
+    uint8_t i;
+
+    /* LSB first */
+    for (i=0; i < 8; i++, data >>= 1)
+        write_bit(data & 1);
+}
+
+template <class DQ>
+uint8_t OneWireBus<DQ>::read_byte()
+{
+    uint8_t i, data = 0;
+
+    for (i=0; i < 8; i++) {
+        data >>= 1;
+        if (read_bit())
+            data |= 0x80;
+    }
+
+    return data;
+}
+
+/**
+ * @brief  Address all devices of the bus. Call after reset().
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+template <class DQ>
+void OneWireBus<DQ>::skip_rom()
+{
+    write_byte(ONE_WIRE_SKIP_ROM);
+}
+
+/**
+ * @brief  Address one device. Call after reset().
+ * @param  rom: 64-bit ROM code.
+ *
+ * @retval Nenhum.
+ */
+template <class DQ>
+void OneWireBus<DQ>::match_rom(const uint8_t *rom)
+{
+    uint8_t i;
+
+    write_byte(ONE_WIRE_MATCH_ROM);
+    for (i=0; i < ONE_WIRE_ROM_SIZE; i++)
+        write_byte(rom[i]);
+}
+
+template <class DQ>
+void OneWireBus<DQ>::reset_search()
+{
+    last_discrepancy = 0;
+    last_device = 0;
+    memset(search_rom_no, 0, sizeof(search_rom_no));
+}
+
+/**
+ * @brief  Find the next device of the bus (Maxim AN187).
+ *         Call reset_search() to start over from the first device.
+ * @param  rom: 8 bytes: ROM code of the device found.
+ *
+ * @retval 1 if a device with a valid ROM CRC was found, 0 when done.
+ */
+template <class DQ>
+uint8_t OneWireBus<DQ>::search_rom(uint8_t *rom)
+{
+    uint8_t id_bit_number = 1;
+    uint8_t last_zero = 0;
+    uint8_t rom_byte_number = 0;
+    uint8_t rom_byte_mask = 1;
+    uint8_t id_bit, cmp_id_bit;
+    uint8_t search_direction;
+
+    if (last_device)
+        return 0;
+
+    if (!reset()) {
+        reset_search();
+        return 0;
+    }
+
+    write_byte(ONE_WIRE_SEARCH_ROM);
+
+    do {
+        /* Bit and its complement from all devices (wired AND) */
+        id_bit = read_bit();
+        cmp_id_bit = read_bit();
+
+        /* No device left */
+        if (id_bit && cmp_id_bit)
+            break;
+
+        if (id_bit != cmp_id_bit) {
+            /* All devices agree */
+            search_direction = id_bit;
+        }
+        else {
+            /* Discrepancy: take the same path as before up to the last
+             * discrepancy, then branch to 1 on it and 0 after it */
+            if (id_bit_number < last_discrepancy)
+                search_direction = (search_rom_no[rom_byte_number] & rom_byte_mask) ? 1 : 0;
+            else
+                search_direction = (id_bit_number == last_discrepancy);
+
+            if (!search_direction)
+                last_zero = id_bit_number;
+        }
+
+        if (search_direction)
+            search_rom_no[rom_byte_number] |= rom_byte_mask;
+        else
+            search_rom_no[rom_byte_number] &= ~rom_byte_mask;
+
+        /* Devices not matching this direction leave the search */
+        write_bit(search_direction);
+
+        id_bit_number++;
+        rom_byte_mask <<= 1;
+
+        if (!rom_byte_mask) {
+            rom_byte_number++;
+            rom_byte_mask = 1;
+        }
+    } while (rom_byte_number < ONE_WIRE_ROM_SIZE);
+
+    /* Incomplete search or CRC error: ROM CRC over 8 bytes must be zero */
+    if (id_bit_number < 65 || crc8_maxim(search_rom_no, ONE_WIRE_ROM_SIZE)) {
+        reset_search();
+        return 0;
+    }
+
+    last_discrepancy = last_zero;
+    if (!last_discrepancy)
+        last_device = 1;
+
+    memcpy(rom, search_rom_no, ONE_WIRE_ROM_SIZE);
+
+    return 1;
+}
+
+template <class DQ>
+void OneWireBus<DQ>::strong_pull_up()
+{
+    DQ::set();
+    DQ::output();
+}
+
+template <class DQ>
+void OneWireBus<DQ>::release()
+{
+    DQ::input();
+    DQ::clear();
+}
+
+#endif /* ONEWIREBUS_H_ */
@@ -6,6 +6,7 @@
  */
 
 #include <lib/i2c_master_f247_g2xxx.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "SSD1306.h"
@@ -20,15 +21,27 @@
         }
 #endif
 
+#ifdef SSD1306_COUNT_OPS
+#define COUNT_OP(op)    (op_count.op++)
+SSD1306::op_count_t SSD1306::op_count;
+#else
+#define COUNT_OP(op)
+#endif
 
 SSD1306::SSD1306(uint8_t i2c_addr)
 {
     my_i2c_addr = i2c_addr;
+    display_on = false;
     /* Clear frame buffer */
     memset(frame_buffer, 0, sizeof(frame_buffer));
+#ifdef OLED_FULL_FRAME
+    /* Display RAM powers up with noise: first Flush() sends it all */
+    dirty_pages = 0xFF;
+    sent_pages = 0;
+#endif
 }
 
-void SSD1306::Init(){
+void SSD1306::Init(bool display_on){
     /* Send all initialization commands */
     send_command_list((uint8_t *)init[0], sizeof(init[0]));
     send_single_command(OLED_HEIGHT - 1);
@@ -45,7 +58,14 @@ void SSD1306::Init(){
     send_single_command(OLED_CMD_SET_PRECHARGE);
     /* Precharge must be followed by 0xF1 */
     send_single_command(0xF1);
-    send_command_list((uint8_t *)init_disp_on, sizeof(init_disp_on));
+    /* Display ON is the last command of the list */
+    send_command_list((uint8_t *)init_disp_on, sizeof(init_disp_on) - (display_on ? 0 : 1));
+    this->display_on = display_on;
+}
+
+void SSD1306::DisplayOn(){
+    send_single_command(OLED_CMD_DISPLAY_ON);
+    display_on = true;
 }
 
 void SSD1306::send_single_command(uint8_t data){
@@ -57,12 +77,18 @@ void SSD1306::send_command_list(uint8_t *data, uint8_t size){
 }
 
 void SSD1306::ClearFrameBuffer(void) {
+    COUNT_OP(clear);
+#ifdef OLED_FULL_FRAME
+    ClearPages(0, OLED_FRAME_PAGES);
+#else
     memset(frame_buffer, 0, sizeof(frame_buffer));
+#endif
 }
 
 void SSD1306::Refresh(){
     uint8_t *data = frame_buffer;
     int i;
+    COUNT_OP(refresh);
     const uint8_t cmd[] = {
                                   0x00,
                                   OLED_CMD_SET_PAGE_RANGE,   // 0x22
@@ -81,11 +107,15 @@ void SSD1306::Refresh(){
 #endif
         i2c_master_write_reg(my_i2c_addr, 0x40, data + i, 128);
     }
+#ifdef OLED_FULL_FRAME
+    dirty_pages = 0;
+#endif
 }
 
 void SSD1306::Refresh(oled_partition_t line){
     uint8_t *data = frame_buffer;
     int i;
+    COUNT_OP(refresh);
     const uint8_t cmd[] = {
                                   0x00,
                                   OLED_CMD_SET_PAGE_RANGE,   // 0x22
@@ -107,9 +137,118 @@ void SSD1306::Refresh(oled_partition_t line){
 
 }
 
+/**
+ * @brief  Queue the pages changed since the last Flush() and return: the
+ *         I2C IRQ sends them while the CPU draws another panel or sleeps
+ *         in LPM0. One window from the first to the last changed page,
+ *         unchanged pages between them are sent too. Pages of a failed
+ *         Flush() are sent again by the next one. Drawing while they
+ *         are sent is allowed: a page changed meanwhile is dirty again.
+ *
+ *         Band mode: nothing to do, each band was sent by Refresh().
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void SSD1306::Flush()
+{
+#ifdef OLED_FULL_FRAME
+    uint8_t page, first, last;
+
+    /* Transactions are reused: wait for the previous Flush() */
+    if (Busy())
+        i2c_flush();
+
+    if (sent_pages) {
+        if (window_xfer.state != IDLE_MODE)
+            dirty_pages |= sent_pages;
+        for (page=0; page < OLED_FRAME_PAGES; page++)
+            if ((sent_pages & (1 << page)) && page_xfer[page].state != IDLE_MODE)
+                dirty_pages |= 1 << page;
+        sent_pages = 0;
+    }
+
+    if (!dirty_pages)
+        return;
+
+    for (first=0; !(dirty_pages & (1 << first)); first++);
+    for (last=OLED_FRAME_PAGES - 1; !(dirty_pages & (1 << last)); last--);
+
+    window[0] = OLED_CMD_SET_PAGE_RANGE;
+    window[1] = first;
+    window[2] = last;
+    window[3] = OLED_CMD_SET_COLUMN_RANGE;
+    window[4] = 0;
+    window[5] = OLED_WIDTH - 1;
+
+    window_xfer.dev_addr = my_i2c_addr;
+    window_xfer.reg_addr = OLED_CONTROL_BYTE_CMD_STREAM;
+    window_xfer.data = window;
+    window_xfer.count = sizeof(window);
+    i2c_queue_write(&window_xfer);
+
+    for (page=first; page <= last; page++) {
+        page_xfer[page].dev_addr = my_i2c_addr;
+        page_xfer[page].reg_addr = OLED_CONTROL_BYTE_DATA_STREAM;
+        page_xfer[page].data = frame_buffer + page * OLED_WIDTH;
+        page_xfer[page].count = OLED_WIDTH;
+        i2c_queue_write(&page_xfer[page]);
+        sent_pages |= 1 << page;
+    }
+
+    dirty_pages = 0;
+#endif
+}
+
+bool SSD1306::Busy()
+{
+#ifdef OLED_FULL_FRAME
+    uint8_t last;
+
+    if (!sent_pages)
+        return false;
+
+    for (last=OLED_FRAME_PAGES - 1; !(sent_pages & (1 << last)); last--);
+
+    /* Queue order: the last page ends the Flush() */
+    return !i2c_queue_done(&page_xfer[last]);
+#else
+    return false;
+#endif
+}
+
+#ifdef OLED_FULL_FRAME
+/**
+ * @brief  Clear whole pages of the frame buffer, only those with pixels
+ *         set become dirty.
+ * @param  first: first page, 0 to 7.
+ *         count: number of pages.
+ *
+ * @retval Nenhum.
+ */
+void SSD1306::ClearPages(uint8_t first, uint8_t count)
+{
+    uint8_t *data;
+    uint8_t i;
+
+    for (; count && first < OLED_FRAME_PAGES; first++, count--) {
+        data = frame_buffer + first * OLED_WIDTH;
+        for (i=0; i < OLED_WIDTH && !data[i]; i++);
+        if (i < OLED_WIDTH) {
+            memset(data, 0, OLED_WIDTH);
+            dirty_pages |= 1 << first;
+        }
+    }
+}
+#endif
+
 void SSD1306::DrawPixel(int16_t x, int16_t y, pixel_color_t color){
+    COUNT_OP(pixel);
     if ((x >= 0) && (x < OLED_WIDTH && (y >= 0) && (y < OLED_HEIGHT))) {
         uint16_t i = x + (y >> 3) * OLED_WIDTH;
+#ifdef OLED_FULL_FRAME
+        uint8_t old = frame_buffer[i];
+#endif
 
         if (i > sizeof(frame_buffer) * 4)
             return;
@@ -122,6 +261,11 @@ void SSD1306::DrawPixel(int16_t x, int16_t y, pixel_color_t color){
             //oled_buffer[x + (y / 8) * OLED_WIDTH] |= (1 << (y & 7));
             //frame_buffer[x + (y >> 3) * OLED_WIDTH] |= (1 << (y & 7));
             frame_buffer[i] |= (1 << (y & 7));
+
+#ifdef OLED_FULL_FRAME
+        if (frame_buffer[i] != old)
+            dirty_pages |= 1 << (y >> 3);
+#endif
     }
 }
 
@@ -130,6 +274,7 @@ void SSD1306::WriteScaledChar(int16_t x, int16_t y, char data, uint8_t scale){
     int8_t i;
     int8_t j;
     const uint8_t *font_ptr =  font8x8_basic_tr[(uint8_t)data];
+    COUNT_OP(scaled_char);
 
     for (i = 0; i < 8; i++) {
         uint8_t line = *(font_ptr + i);
@@ -145,6 +290,7 @@ void SSD1306::WriteScaledChar(int16_t x, int16_t y, char data, uint8_t scale){
 
 
 void SSD1306::WriteLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, pixel_color_t color){
+    COUNT_OP(line);
     int16_t steep = abs(y1 - y0) > abs(x1 - x0);
     if (steep) {
         _swap_int16_t(x0, y0);
@@ -190,6 +336,7 @@ void SSD1306::WriteFastVLine(int16_t x, int16_t y, int16_t h, pixel_color_t colo
 
 void SSD1306::FillRect(int16_t x, int16_t y, int16_t w, int16_t h, pixel_color_t color){
     int16_t i;
+    COUNT_OP(rect);
     for (i = x; i < x + w; i++) {
         WriteFastVLine(i, y, h, color);
     }
@@ -10,6 +10,8 @@
 
 #include <stdint.h>
 
+#include <lib/i2c_master_f247_g2xxx.h>
+
 /* Following definitions are from:
    http://robotcantalk.blogspot.com/2015/03/interfacing-arduino-with-ssd1306-driven.html
 */
@@ -22,6 +24,22 @@
 #define OLED_HEIGHT 64
 #define OLED_WIDTH 128
 
+/* Frame buffer: one band of two pages on the G2553 (512B of RAM), sent
+ * by Refresh() as soon as it is drawn. Elsewhere the whole display
+ * (OLED_FULL_FRAME): pages changed by the drawing are tracked and sent
+ * in the background by Flush(), so several panels can share the bus */
+#if defined(__MSP430G2553__)
+#define OLED_FRAME_PAGES 2
+#else
+#define OLED_FRAME_PAGES 8
+#define OLED_FULL_FRAME
+#endif
+
+/* VDD on to first command: the RC reset of the usual I2C modules
+ * releases RES# within ~10ms (datasheet: RES# low >= 3us once VDD is
+ * stable) */
+#define OLED_POWER_UP_MS 20
+
 // Control byte
 #define OLED_CONTROL_BYTE_CMD_SINGLE    0x80
 #define OLED_CONTROL_BYTE_CMD_STREAM    0x00
@@ -79,7 +97,11 @@ public:
 
     SSD1306(uint8_t i2c_addr);
 
-    void Init();
+    /* display_on false: RAM can be drawn before DisplayOn() */
+    void Init(bool display_on = true);
+    void DisplayOn();
+    /* Panel lit: it warms the board (SelfHeating.h) */
+    bool IsOn() const { return display_on; }
     void ClearFrameBuffer(void);
     void DrawPixel(int16_t x, int16_t y, pixel_color_t color);
     void FillRect(int16_t x, int16_t y, int16_t w, int16_t h, pixel_color_t color);
@@ -88,9 +110,30 @@ public:
     void WriteScaledChar(int16_t x, int16_t y, char data, uint8_t scale);
     void Refresh();
     void Refresh(oled_partition_t line);
+    /* Queue the changed pages, band mode: nothing, Refresh() sent them */
+    void Flush();
+    /* Pages of the last Flush() still queued */
+    bool Busy();
+#ifdef OLED_FULL_FRAME
+    void ClearPages(uint8_t first, uint8_t count);
+#endif
+
+#ifdef SSD1306_COUNT_OPS
+    /* Calls of each primitive, nested calls included: host benchmarks */
+    struct op_count_t {
+        uint32_t pixel;
+        uint32_t line;
+        uint32_t rect;
+        uint32_t scaled_char;
+        uint32_t clear;
+        uint32_t refresh;
+    };
+    static op_count_t op_count;
+#endif
 
 private:
     uint8_t my_i2c_addr;
+    bool display_on;
 
 #if defined(__MSP430G2553__)
     /* Not enough RAM for 1k OLED frame Buffer *
@@ -99,6 +142,15 @@ private:
 #else
     /*1k OLED frame Buffer */
     uint8_t frame_buffer[(OLED_WIDTH * ((OLED_HEIGHT + 7) / 8))];
+
+    /* Pages that differ from the display RAM, bit n: page n */
+    uint8_t dirty_pages;
+    /* Pages sent by the last Flush(): dirty again if it failed */
+    uint8_t sent_pages;
+    /* Page and column range of the last Flush(), then one write per page */
+    uint8_t window[6];
+    i2c_transaction_t window_xfer;
+    i2c_transaction_t page_xfer[OLED_FRAME_PAGES];
 #endif
 
     void send_single_command(uint8_t data);
@@ -0,0 +1,193 @@
+/*
+ * Scheduler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Cooperative scheduler over a static task table. A task runs every
+ *      interval ticks (watchdog intervals), when one of its event bits is
+ *      raised, or both. run() calls the due tasks in table order until
+ *      none is left; tasks never preempt each other.
+ *
+ *          const Scheduler<App, 2>::Task App::tasks[2] = {
+ *              { &App::sample,  10, 0 },
+ *              { &App::display, 0,  EVENT_SAMPLE },
+ *          };
+ *
+ *      tick() and signal() may be called from ISRs. set_interval()
+ *      changes the interval of a periodic task at run time.
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <msp430.h>
+#include <stdint.h>
+
+template <class OWNER, uint8_t N>
+class Scheduler
+{
+    static_assert(N > 0 && N <= 8, "one due bit per task");
+
+public:
+    struct Task {
+        void (OWNER::*run)();
+        /* Ticks between two runs, 0: only on events */
+        uint16_t interval;
+        /* Event bits that make the task due */
+        uint8_t events;
+    };
+
+    Scheduler(const Task *table);
+
+    uint8_t tick();
+    void signal(uint8_t bits);
+    uint8_t pending();
+    void run(OWNER *owner);
+    void set_interval(void (OWNER::*task)(), uint16_t ticks);
+
+private:
+    const Task *tasks;
+    /* Current intervals: the table holds the initial ones */
+    uint16_t interval[N];
+    uint16_t countdown[N];
+
+    volatile uint8_t due;
+    volatile uint8_t events;
+};
+
+template <class OWNER, uint8_t N>
+Scheduler<OWNER, N>::Scheduler(const Task *table)
+{
+    uint8_t i;
+
+    tasks = table;
+    due = 0;
+    events = 0;
+
+    for (i = 0; i < N; i++) {
+        interval[i] = tasks[i].interval;
+        countdown[i] = interval[i];
+    }
+}
+
+/**
+ * @brief  One tick elapsed: periodic tasks whose interval expired
+ *         become due. Called by the watchdog ISR.
+ * @param  Nenhum
+ *
+ * @retval 1 if a task became due: the CPU must wake up.
+ */
+template <class OWNER, uint8_t N>
+uint8_t Scheduler<OWNER, N>::tick()
+{
+    uint8_t i;
+    uint8_t wake = 0;
+
+    for (i = 0; i < N; i++) {
+        if (!interval[i])
+            continue;
+
+        if (--countdown[i] == 0) {
+            countdown[i] = interval[i];
+            due |= 1 << i;
+            wake = 1;
+        }
+    }
+
+    return wake;
+}
+
+/**
+ * @brief  Raise event bits. Tasks waiting for any of them run on the
+ *         next pass of run().
+ * @param  bits: event bits.
+ *
+ * @retval Nenhum.
+ */
+template <class OWNER, uint8_t N>
+void Scheduler<OWNER, N>::signal(uint8_t bits)
+{
+    uint16_t gie = __get_SR_register() & GIE;
+
+    __disable_interrupt();
+    events |= bits;
+    if (gie)
+        __enable_interrupt();
+}
+
+/**
+ * @brief  Test before sleeping, with interrupts disabled.
+ * @param  Nenhum
+ *
+ * @retval 1 if a task is due or an event is raised.
+ */
+template <class OWNER, uint8_t N>
+uint8_t Scheduler<OWNER, N>::pending()
+{
+    return due || events;
+}
+
+/**
+ * @brief  Run the due tasks, in table order, until none is left: events
+ *         raised by a task are served in the same call.
+ * @param  owner: object the task table belongs to.
+ *
+ * @retval Nenhum.
+ */
+template <class OWNER, uint8_t N>
+void Scheduler<OWNER, N>::run(OWNER *owner)
+{
+    uint8_t run_mask;
+    uint8_t raised;
+    uint8_t i;
+
+    while (1) {
+        /* ISRs keep adding to both sets */
+        __disable_interrupt();
+        run_mask = due;
+        raised = events;
+        due = 0;
+        events = 0;
+        __enable_interrupt();
+
+        for (i = 0; i < N; i++)
+            if (raised & tasks[i].events)
+                run_mask |= 1 << i;
+
+        if (!run_mask)
+            return;
+
+        for (i = 0; i < N; i++)
+            if (run_mask & (1 << i))
+                (owner->*tasks[i].run)();
+    }
+}
+
+/**
+ * @brief  New interval of a periodic task, counted from now.
+ * @param  task: member function of the task table.
+ * @param  ticks: ticks between two runs, 0: only on events.
+ *
+ * @retval Nenhum.
+ */
+template <class OWNER, uint8_t N>
+void Scheduler<OWNER, N>::set_interval(void (OWNER::*task)(), uint16_t ticks)
+{
+    uint16_t gie = __get_SR_register() & GIE;
+    uint8_t i;
+
+    for (i = 0; i < N; i++) {
+        if (tasks[i].run != task)
+            continue;
+
+        /* tick() updates the countdown */
+        __disable_interrupt();
+        interval[i] = ticks;
+        countdown[i] = ticks;
+        if (gie)
+            __enable_interrupt();
+    }
+}
+
+#endif /* SCHEDULER_H_ */
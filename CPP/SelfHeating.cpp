@@ -0,0 +1,89 @@
+/*
+ * SelfHeating.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include "SelfHeating.h"
+
+#define HEAT_Q15_ONE            32768U
+
+SelfHeating::SelfHeating()
+{
+    oled_heat = 0;
+#ifdef HEAT_BOARD_TERM
+    board_filter = 0;
+    have_board = 0;
+#endif
+    offset = 0;
+}
+
+/**
+ * @brief  Advance the OLED warm-up to the time of a reading.
+ * @param  oled_on: the OLED was on since the previous reading.
+ * @param  elapsed: ticks since the previous reading.
+ *
+ * @retval Nenhum.
+ */
+void SelfHeating::advance(uint8_t oled_on, uint16_t elapsed)
+{
+    uint16_t decay = HEAT_OLED_DECAY_Q15;
+    uint16_t target = oled_on ? HEAT_Q15_ONE - 1 : 0;
+
+    if (!elapsed)
+        return;
+
+    /* x = target + (x - target) * decay^elapsed */
+    while (--elapsed && decay)
+        decay = ((uint32_t)decay * HEAT_OLED_DECAY_Q15) >> 15;
+
+    oled_heat = (uint16_t)(target + ((((int32_t)oled_heat - target) * decay) >> 15));
+}
+
+#ifdef HEAT_BOARD_TERM
+/**
+ * @brief  Air temperature from a reading and the die temperature.
+ * @param  temp: DHT22 reading, tenths of oC.
+ * @param  board: die temperature, tenths of oC.
+ *
+ * @retval Air temperature, tenths of oC.
+ */
+int16_t SelfHeating::correct(int16_t temp, int16_t board)
+#else
+/**
+ * @brief  Air temperature from a reading: OLED warming only.
+ * @param  temp: DHT22 reading, tenths of oC.
+ *
+ * @retval Air temperature, tenths of oC.
+ */
+int16_t SelfHeating::correct(int16_t temp)
+#endif
+{
+    int32_t corrected;
+    int32_t x;
+
+    corrected = temp - (((int32_t)HEAT_OLED_RISE * oled_heat + (HEAT_Q15_ONE >> 1)) >> 15);
+
+#ifdef HEAT_BOARD_TERM
+    if (!have_board) {
+        have_board = 1;
+        board_filter = (int16_t)(board << HEAT_BOARD_FILTER_SHIFT);
+    }
+    else
+        board_filter += board - (board_filter >> HEAT_BOARD_FILTER_SHIFT);
+
+    /* Fraction bits of the filter kept in the product */
+    corrected -= (((int32_t)board_filter - (corrected << HEAT_BOARD_FILTER_SHIFT)) *
+                  HEAT_BOARD_GAIN_Q8 + (128 << HEAT_BOARD_FILTER_SHIFT)) >> (8 + HEAT_BOARD_FILTER_SHIFT);
+#endif
+
+    x = temp - corrected;
+    if (x > HEAT_MAX_OFFSET)
+        x = HEAT_MAX_OFFSET;
+    if (x < -HEAT_MAX_OFFSET)
+        x = -HEAT_MAX_OFFSET;
+    offset = (int16_t)x;
+
+    return (int16_t)(temp - offset);
+}
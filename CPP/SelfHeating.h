@@ -0,0 +1,93 @@
+/*
+ * SelfHeating.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Air temperature from a DHT22 warmed by its own board. Two heat
+ *      sources are modelled:
+ *
+ *          OLED   the panel warms the sensor next to it as a first order
+ *                 lag of its on time, up to HEAT_OLED_RISE.
+ *          board  everything else (charger, regulator, MCU) warms the
+ *                 board as a whole: measured by the die temperature
+ *                 sensor of the MCU (lib/adc10.h). A share G of the
+ *                 board warming reaches the DHT22.
+ *
+ *      With x the OLED warm-up (0 to 1) and Tb the die temperature:
+ *
+ *          Td  = Tair + rise * x + G * (Tb - Tair)
+ *          Tair = Td' - G / (1 - G) * (Tb - Td'),   Td' = Td - rise * x
+ *
+ *      The constants depend on the enclosure and the board layout: they
+ *      are measured on an assembled unit against a reference thermometer
+ *      and defaulted here for the reference board.
+ *
+ *          heating.advance(oled_on, ticks);      every reading, failed too
+ *          temp = heating.correct(dht_tenths, die_tenths);
+ *          temp = heating.correct(dht_tenths);   F247: no die reading
+ */
+
+#ifndef SELFHEATING_H_
+#define SELFHEATING_H_
+
+#include <stdint.h>
+
+/* Board term: die temperature from the ADC10 of the G2553. The F247 has
+ * an ADC12 and no ADC10 calibration: the OLED term only */
+#if defined(__MSP430G2553__)
+#define HEAT_BOARD_TERM
+#endif
+
+/* DHT22 rise after a long time with the OLED on: tenths of oC */
+#ifndef HEAT_OLED_RISE
+#define HEAT_OLED_RISE          8
+#endif
+
+/* exp(-tick / tau) of the OLED warm-up, Q15: tau ~4min, tick ~2.7s (VLO) */
+#ifndef HEAT_OLED_DECAY_Q15
+#define HEAT_OLED_DECAY_Q15     32401
+#endif
+
+/* G / (1 - G), Q8: G = 0.3 of the board warming reaches the DHT22 */
+#ifndef HEAT_BOARD_GAIN_Q8
+#define HEAT_BOARD_GAIN_Q8      110
+#endif
+
+/* Die temperature filter: 1 / 2^shift of each reading. The board warms
+ * over minutes, a step of the ADC (~0.4oC) would show in every reading */
+#ifndef HEAT_BOARD_FILTER_SHIFT
+#define HEAT_BOARD_FILTER_SHIFT 2
+#endif
+
+/* Largest correction, tenths of oC: bounds a wrong die reading */
+#ifndef HEAT_MAX_OFFSET
+#define HEAT_MAX_OFFSET         50
+#endif
+
+class SelfHeating
+{
+public:
+    SelfHeating();
+
+    void advance(uint8_t oled_on, uint16_t elapsed);
+#ifdef HEAT_BOARD_TERM
+    int16_t correct(int16_t temp, int16_t board);
+#else
+    int16_t correct(int16_t temp);
+#endif
+    int16_t get_offset() { return offset; }
+
+private:
+    /* OLED warm-up x, Q15 */
+    uint16_t oled_heat;
+#ifdef HEAT_BOARD_TERM
+    /* Filtered die temperature, tenths << HEAT_BOARD_FILTER_SHIFT */
+    int16_t board_filter;
+    uint8_t have_board;
+#endif
+    /* Last correction: reading - air, tenths */
+    int16_t offset;
+};
+
+#endif /* SELFHEATING_H_ */
@@ -0,0 +1,53 @@
+/*
+ * Sht3x.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <lib/i2c_master_f247_g2xxx.h>
+#include <lib/timer_delay.h>
+#include <lib/crc.h>
+
+#include "Sht3x.h"
+
+Sht3x::Sht3x(uint8_t i2c_addr)
+{
+    my_i2c_addr = i2c_addr;
+}
+
+/**
+ * @brief  Single shot measurement.
+ * @param  Nenhum
+ *
+ * @retval 1 if both words have a valid CRC.
+ */
+uint8_t Sht3x::read()
+{
+    uint8_t cmd_lsb = SHT3X_CMD_MEASURE_HIGH_LSB;
+    /* T msb, T lsb, T crc, RH msb, RH lsb, RH crc */
+    uint8_t data[6];
+    uint16_t raw;
+
+    /* 16-bit command: MSB goes in the register address position */
+    if (i2c_master_write_reg(my_i2c_addr, SHT3X_CMD_MEASURE_HIGH_MSB, &cmd_lsb, 1) != IDLE_MODE)
+        return 0;
+
+    timer_delay_ms(SHT3X_MEASUREMENT_MS);
+
+    if (i2c_master_read(my_i2c_addr, sizeof(data), data) != IDLE_MODE)
+        return 0;
+
+    if (crc8_sensirion(data, 2) != data[2] || crc8_sensirion(data + 3, 2) != data[5])
+        return 0;
+
+    /* T = -45 + 175 * raw / 2^16 : tenths of oC, rounded */
+    raw = data[0] << 8 | data[1];
+    temperature = (int16_t)(((uint32_t)raw * 1750 + 0x8000) >> 16) - 450;
+
+    /* RH = 100 * raw / 2^16 : tenths of % */
+    raw = data[3] << 8 | data[4];
+    humidity = ((uint32_t)raw * 1000 + 0x8000) >> 16;
+
+    return 1;
+}
@@ -0,0 +1,37 @@
+/*
+ * Sht3x.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Sensirion SHT30/31/35 humidity sensor: single shot measurement,
+ *      no clock stretching. CPU sleeps in LPM0 during the conversion.
+ */
+
+#ifndef SHT3X_H_
+#define SHT3X_H_
+
+#include <stdint.h>
+
+#include "HygroSensor.h"
+
+#define SHT3X_I2C_ADDRESS           0x44
+
+/* Single shot, high repeatability, clock stretching disabled */
+#define SHT3X_CMD_MEASURE_HIGH_MSB  0x24
+#define SHT3X_CMD_MEASURE_HIGH_LSB  0x00
+/* High repeatability: 15.5ms max */
+#define SHT3X_MEASUREMENT_MS        16
+
+class Sht3x: public HygroSensor
+{
+public:
+    Sht3x(uint8_t i2c_addr);
+
+    uint8_t read();
+
+private:
+    uint8_t my_i2c_addr;
+};
+
+#endif /* SHT3X_H_ */
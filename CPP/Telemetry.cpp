@@ -0,0 +1,43 @@
+/*
+ * Telemetry.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <lib/uart.h>
+
+#include "Telemetry.h"
+
+Telemetry::Telemetry()
+{
+    my_node_id = 0;
+    seq = 0;
+}
+
+void Telemetry::Init(uint16_t node_id)
+{
+    my_node_id = node_id;
+
+    init_uart();
+}
+
+/**
+ * @brief  Encode and queue one sample. Node address and sequence
+ *         number are filled in here.
+ * @param  sample: sample to send.
+ *
+ * @retval 1 if the whole frame was queued.
+ */
+uint8_t Telemetry::send(telemetry_sample_t *sample)
+{
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    uint8_t size;
+
+    sample->node = my_node_id;
+    sample->seq = seq++;
+
+    size = telemetry_encode(sample, frame);
+
+    return uart_write(frame, size) == size;
+}
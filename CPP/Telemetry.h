@@ -0,0 +1,32 @@
+/*
+ * Telemetry.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Sample records sent as binary frames (lib/telemetry_frame.h)
+ *      over the USCI_A0 UART. send() only encodes and queues the frame:
+ *      transmission is done by IRQ while the CPU sleeps.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+
+#include <lib/telemetry_frame.h>
+
+class Telemetry
+{
+public:
+    Telemetry();
+
+    void Init(uint16_t node_id);
+    uint8_t send(telemetry_sample_t *sample);
+
+private:
+    uint16_t my_node_id;
+    uint16_t seq;
+};
+
+#endif /* TELEMETRY_H_ */
@@ -0,0 +1,371 @@
+/*
+ * ThermoHygrometer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <msp430.h>
+
+#include <lib/adc10.h>
+#include <lib/i2c_master_f247_g2xxx.h>
+#include <lib/node_config.h>
+#include <lib/rs485.h>
+#include <lib/timer_delay.h>
+#include <lib/uart.h>
+
+#include "ThermoHygrometer.h"
+
+/* Table order is run order: a poll is answered first, the frame is
+ * queued before the display is rendered and sent meanwhile */
+const Scheduler<ThermoHygrometer, ThermoHygrometer::TASKS>::Task
+ThermoHygrometer::task_table[ThermoHygrometer::TASKS] = {
+#ifdef TELEMETRY_RS485
+    { &ThermoHygrometer::bus,       0,                    EVENT_POLL },
+#endif
+    { &ThermoHygrometer::sample,    SAMPLE_MIN_WDT_TICKS, 0 },
+#ifdef SENSOR_POWER_GATED
+    /* Armed by sample() when the sensor is switched off */
+    { &ThermoHygrometer::sensor_power, 0,                 0 },
+#endif
+#ifdef BOARD_ADC10
+    { &ThermoHygrometer::battery,   BATTERY_WDT_TICKS,    0 },
+#endif
+    { &ThermoHygrometer::telemetry, 0,                    EVENT_SAMPLE },
+    { &ThermoHygrometer::display,   0,                    EVENT_SAMPLE },
+};
+
+ThermoHygrometer::ThermoHygrometer(uint16_t node_id) :
+    my_oled(OLED_I2C_ADDRESS),
+    my_screen(my_oled),
+#ifdef OLED_SECOND_I2C_ADDRESS
+    my_oled2(OLED_SECOND_I2C_ADDRESS),
+    my_screen2(my_oled2),
+#endif
+    my_scheduler(task_table),
+    my_rate(SAMPLE_MIN_WDT_TICKS, SAMPLE_MAX_WDT_TICKS)
+{
+    my_node_id = node_id;
+    wdt_ticks = 0;
+    sensor_errors = 0;
+    battery_volts = 0;
+    my_sample.battery_mv = 0;
+    my_sample.timestamp = 0;
+}
+
+/**
+ * @brief  Peripherals and display initialization, then the first
+ *         reading. The DHT22 is powered first and the OLED is set up
+ *         while its power-up time runs, then turned on once the reading
+ *         is drawn.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void ThermoHygrometer::Init()
+{
+#ifdef LED_DEBUG
+    /* Debug LED */
+    LedPin::output();
+    LedPin::set();
+#endif
+    my_temp_sensor.power_on();
+    init_i2c_master_mode();
+#ifdef BOARD_ADC10
+    adc10_temperature_init(BOARD_TEMP_SAMPLES);
+#endif
+
+    my_node_id = node_config_address(my_node_id);
+#ifdef TELEMETRY_UART
+    my_telemetry.Init(my_node_id);
+#endif
+#ifdef TELEMETRY_RS485
+    my_bus.Init(my_node_id);
+#endif
+
+    /* OLED reset released by its RC network */
+    timer_delay_ms(OLED_POWER_UP_MS);
+
+    /* Init OLED display AFTER i2c initializaion. Off until the first
+     * show(): its RAM powers up with noise */
+    my_oled.Init(false);
+    my_screen.clear_comfort();
+#ifdef OLED_SECOND_I2C_ADDRESS
+    my_oled2.Init(false);
+    my_screen2.clear_comfort();
+#endif
+
+    /* Rest of the DHT22 power-up time, OLED init time not counted */
+    timer_delay_ms(DHT22_POWER_UP_MS - OLED_POWER_UP_MS);
+
+#ifdef BOARD_ADC10
+    battery();
+#endif
+    sample();
+    my_scheduler.run(this);
+    my_oled.DisplayOn();
+#ifdef OLED_SECOND_I2C_ADDRESS
+    my_oled2.DisplayOn();
+#endif
+
+    set_clock(APP_IDLE_MHZ);
+}
+
+/**
+ * @brief  Main loop work after a wake-up: the due tasks, then back to
+ *         the idle clock.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void ThermoHygrometer::Update()
+{
+#ifdef TELEMETRY_RS485
+    if (rs485_request())
+        my_scheduler.signal(EVENT_POLL);
+#endif
+
+    my_scheduler.run(this);
+
+#ifdef TELEMETRY_UART
+    /* A few ms in LPM0, then LPM3 until the next task */
+    uart_flush();
+#endif
+    set_clock(APP_IDLE_MHZ);
+}
+
+uint8_t ThermoHygrometer::pending()
+{
+#ifdef TELEMETRY_RS485
+    if (rs485_request())
+        return 1;
+#endif
+
+    return my_scheduler.pending();
+}
+
+/**
+ * @brief  LPM3 unless a UART frame or queued display pages are still
+ *         being sent: USCI_A0 and USCI_B0 need SMCLK. The RS-485 receiver
+ *         turns SMCLK back on by itself at the RX start edge.
+ * @param  Nenhum
+ *
+ * @retval Status register bits of the low power mode.
+ */
+uint16_t ThermoHygrometer::sleep_bits()
+{
+    if (uart_tx_busy() || i2c_queue_busy())
+        return LPM0_bits;
+
+    return LPM3_bits;
+}
+
+/**
+ * @brief  Sensor task: DHT22 reading at CLOCK_MHZ_FAST, corrected for
+ *         the warming of its own board. The next one is scheduled by the
+ *         rate of change of the readings.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void ThermoHygrometer::sample()
+{
+    uint8_t result;
+#ifdef BOARD_ADC10
+    int16_t board;
+#endif
+    uint16_t interval;
+    uint16_t elapsed = (uint16_t)(wdt_ticks - my_sample.timestamp);
+
+#ifdef LED_DEBUG
+    LedPin::toggle();
+#endif
+    set_clock(CLOCK_MHZ_FAST);
+    /* No queued I2C write may run its ISRs inside the frame. set_clock()
+     * only flushes when the clock changes */
+    i2c_flush();
+
+    result = my_temp_sensor.dht_response();
+    my_heating.advance(my_oled.IsOn(), elapsed);
+
+    if (result == DHT22_OK) {
+        my_sample.status = TELEMETRY_STATUS_VALID;
+#ifdef BOARD_ADC10
+        /* Die temperature in the same wake-up: the board warming */
+        board = adc10_temperature(adc10_read(ADC10_INCH_TEMP, ADC10_REF_1V5, BOARD_TEMP_SAMPLES));
+        my_sample.temperature = my_heating.correct((int16_t)my_temp_sensor.get_temp(), board);
+#else
+        my_sample.temperature = my_heating.correct((int16_t)my_temp_sensor.get_temp());
+#endif
+        my_sample.humidity = my_temp_sensor.get_humid();
+
+        /* Rate of the reading itself: the correction moves with the ADC
+         * steps of the die sensor, not with the air */
+        my_rate.update((int16_t)my_temp_sensor.get_temp(), my_sample.humidity, elapsed);
+        my_humi_lag.update(my_sample.humidity, elapsed);
+    }
+    else {
+        my_sample.status = (uint8_t)(result << 1);
+        my_sample.temperature = 0;
+        my_sample.humidity = 0;
+        sensor_errors++;
+
+        my_rate.reset();
+        my_humi_lag.reset();
+    }
+    my_sample.timestamp = wdt_ticks;
+    interval = my_rate.get_interval();
+    my_scheduler.set_interval(&ThermoHygrometer::sample, interval);
+
+#ifdef SENSOR_POWER_GATED
+    /* Off until its warm-up before the next reading, spent in LPM3. At
+     * the shortest intervals it stays on: the warm-up would not fit */
+    if (interval > SENSOR_WARMUP_WDT_TICKS) {
+        my_temp_sensor.power_off();
+        my_scheduler.set_interval(&ThermoHygrometer::sensor_power,
+                                  interval - SENSOR_WARMUP_WDT_TICKS);
+    }
+#endif
+
+    my_scheduler.signal(EVENT_SAMPLE);
+}
+
+#ifdef BOARD_ADC10
+/**
+ * @brief  Battery task: it discharges over days, no need to convert on
+ *         every sample.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void ThermoHygrometer::battery()
+{
+    battery_volts = my_battery.get_voltage();
+    my_sample.battery_mv = my_battery.get_millivolts();
+}
+#endif
+
+/**
+ * @brief  Telemetry task: the last sample with the current error
+ *         counters, sent on the UART or kept for the next bus poll.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void ThermoHygrometer::telemetry()
+{
+    const i2c_stats_t *i2c_stats = i2c_get_stats();
+
+    my_sample.i2c_errors = i2c_stats->nack + i2c_stats->timeout;
+    my_sample.sensor_errors = sensor_errors;
+
+#ifdef TELEMETRY_UART
+    my_telemetry.send(&my_sample);
+#endif
+#ifdef TELEMETRY_RS485
+    my_bus.add(&my_sample);
+#endif
+}
+
+/**
+ * @brief  Display task: rendering is CPU bound, done at CLOCK_MHZ_FAST.
+ *         After a fast humidity change the projected settled value is
+ *         shown instead of the lagging reading. Telemetry always carries
+ *         the reading. The comfort band is derived from the reading.
+ *         With a full frame buffer the changed pages of a panel are
+ *         queued on the I2C bus and the next panel is drawn meanwhile.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void ThermoHygrometer::display()
+{
+    uint8_t estimated = my_humi_lag.is_estimated();
+    uint8_t valid = my_sample.status & TELEMETRY_STATUS_VALID;
+    Celsius temp = Celsius::from_scaled<10>(my_sample.temperature);
+    Percent humi = Percent::from_scaled<10>((int16_t)my_sample.humidity);
+    uint8_t hot = my_sample.temperature >= HEAT_INDEX_MIN_TENTHS;
+    int16_t dew_point = 0;
+    uint16_t comfort = 0;
+    uint8_t i;
+#ifdef OLED_SECOND_I2C_ADDRESS
+    MainScreen *screens[OLED_PANELS] = { &my_screen, &my_screen2 };
+#else
+    MainScreen *screens[OLED_PANELS] = { &my_screen };
+#endif
+
+    set_clock(CLOCK_MHZ_FAST);
+
+    if (valid) {
+        dew_point = (int16_t)Comfort::dew_point(temp, humi).to_scaled<10>();
+        comfort = hot ? (uint16_t)Comfort::heat_index(temp, humi).to_scaled<10>() :
+                        (uint16_t)Comfort::absolute_humidity(temp, humi).to_scaled<10>();
+    }
+
+    for (i=0; i < OLED_PANELS; i++) {
+        screens[i]->show(my_sample.temperature,
+                         estimated ? my_humi_lag.get_value() : my_sample.humidity,
+                         battery_volts, estimated);
+
+        if (valid)
+            screens[i]->show_comfort(dew_point, comfort, hot);
+        else
+            screens[i]->clear_comfort();
+
+        screens[i]->send();
+    }
+}
+
+#ifdef SENSOR_POWER_GATED
+/**
+ * @brief  Sensor power task: one shot, SENSOR_WARMUP_WDT_TICKS before
+ *         the reading it was armed for.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void ThermoHygrometer::sensor_power()
+{
+    my_temp_sensor.power_on();
+    my_scheduler.set_interval(&ThermoHygrometer::sensor_power, 0);
+}
+#endif
+
+#ifdef TELEMETRY_RS485
+/**
+ * @brief  Bus task: answer a poll of the collector.
+ * @param  Nenhum
+ *
+ * @retval Nenhum.
+ */
+void ThermoHygrometer::bus()
+{
+    my_bus.service();
+}
+#endif
+
+/**
+ * @brief  Change MCLK/SMCLK. Queued UART bytes and I2C writes are sent
+ *         at the old clock first; the I2C master follows on its next
+ *         transfer.
+ * @param  mhz: DCO calibration, up to CLOCK_MHZ_FAST.
+ *
+ * @retval Nenhum.
+ */
+void ThermoHygrometer::set_clock(uint8_t mhz)
+{
+    if (clock_get_mhz() == mhz)
+        return;
+
+    uart_flush();
+    i2c_flush();
+    if (clock_set_mhz(mhz))
+        uart_update_clock();
+}
+
+uint8_t ThermoHygrometer::watchdog_tick()
+{
+    wdt_ticks++;
+
+    return my_scheduler.tick();
+}
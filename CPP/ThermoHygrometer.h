@@ -0,0 +1,215 @@
+/*
+ * ThermoHygrometer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Application: reads the DHT22 and the battery, shows them on the
+ *      OLED and sends a telemetry sample. Each job is a task of a static
+ *      table (Scheduler.h) with its own cadence, so the CPU only wakes up
+ *      for work that is due. All application state lives in this class so
+ *      host builds can run several instances side by side; main.cpp only
+ *      configures the clocks, the watchdog and the ISR.
+ */
+
+#ifndef THERMOHYGROMETER_H_
+#define THERMOHYGROMETER_H_
+
+#include <stdint.h>
+
+#include "lib/pin.h"
+#include "lib/clock.h"
+
+#include "SSD1306.h"
+#include "MainScreen.h"
+#include "Dht22.h"
+#include "Battery.h"
+#include "Telemetry.h"
+#include "BusNode.h"
+#include "Scheduler.h"
+#include "AdaptiveRate.h"
+#include "LagEstimator.h"
+#include "Comfort.h"
+#include "SelfHeating.h"
+
+#define OLED_I2C_ADDRESS   0x3C
+
+/* Second panel of the dual-panel wall units, same screen. Each panel
+ * needs a full frame buffer (SSD1306.h): not on the G2553 */
+// #define OLED_SECOND_I2C_ADDRESS 0x3D
+#ifdef OLED_SECOND_I2C_ADDRESS
+#ifndef OLED_FULL_FRAME
+#error "OLED_SECOND_I2C_ADDRESS: no RAM for a second frame buffer"
+#endif
+#define OLED_PANELS        2
+#else
+#define OLED_PANELS        1
+#endif
+
+#define LED_DEBUG
+
+/* Telemetry link:
+ *   TELEMETRY_UART : every sample is sent on USCI_A0 TX (P1.2 on G2553)
+ *   TELEMETRY_RS485: samples are sent when polled by the collector of an
+ *                    RS-485 bus (lib/rs485.h), the CPU sleeps in LPM3 */
+// #define TELEMETRY_RS485
+#ifndef TELEMETRY_RS485
+#define TELEMETRY_UART
+#endif
+
+/* DHT22 supply (Dht22.h): on VCC, or with SENSOR_POWER_GATED switched
+ * by P2.1 (boards with the high side switch), on from one watchdog
+ * interval before a reading to its end */
+// #define SENSOR_POWER_GATED
+
+/* ADC10 readings (lib/adc10.c): battery voltage and die temperature,
+ * G2553 only. The F247 has an ADC12 and no ADC10 calibration in its TLV:
+ * there both are compiled out, the screen and telemetry show 0V and the
+ * DHT22 is corrected for the OLED warming only (SelfHeating.h) */
+#if defined(__MSP430G2553__)
+#define BOARD_ADC10
+#endif
+
+/* Node address when information memory is erased (lib/node_config.h) */
+#define TELEMETRY_NODE_ID  1
+
+/* MCLK between measurements (lib/clock.h). The sensor read and the
+ * display update run at CLOCK_MHZ_FAST: the DHT22 timing is built for
+ * it and rendering is CPU bound. CLOCK_MHZ_FAST: never switch */
+#ifndef APP_IDLE_MHZ
+#define APP_IDLE_MHZ       CLOCK_MHZ_SLOW
+#endif
+
+/* Task intervals in watchdog intervals (~2.7s on the VLO). The display
+ * and the telemetry follow every new sample */
+#define BATTERY_WDT_TICKS  60
+
+/* Bounds of the adaptive sample interval (AdaptiveRate.h): the DHT22
+ * needs 2s between readings, ~60s when the readings are stable. One
+ * watchdog interval is only 1.6s on a 20kHz VLO: two at least */
+#ifndef SAMPLE_MIN_WDT_TICKS
+#define SAMPLE_MIN_WDT_TICKS   2
+#endif
+#ifndef SAMPLE_MAX_WDT_TICKS
+#define SAMPLE_MAX_WDT_TICKS   22
+#endif
+static_assert(SAMPLE_MIN_WDT_TICKS >= 2, "DHT22 read faster than every 2s");
+static_assert(SAMPLE_MAX_WDT_TICKS >= SAMPLE_MIN_WDT_TICKS, "sample interval bounds");
+
+/* Watchdog intervals the gated DHT22 is on before a reading: one is
+ * over 1.6s even on a 20kHz VLO, DHT22_POWER_UP_MS is 1s */
+#define SENSOR_WARMUP_WDT_TICKS 1
+
+/* Die temperature conversions summed per reading: ~0.1oC steps */
+#define BOARD_TEMP_SAMPLES     4
+
+/* Comfort band: heat index instead of absolute humidity from this
+ * temperature, tenths of oC (NWS: caution from 27oC) */
+#define HEAT_INDEX_MIN_TENTHS  270
+
+/* Board pins */
+typedef Pin<Port1, BIT0> LedPin;
+typedef Pin<Port2, BIT0> DhtPin;
+#ifdef SENSOR_POWER_GATED
+typedef Pin<Port2, BIT1> DhtPowerPin;
+#else
+typedef NoPin DhtPowerPin;
+#endif
+#if defined(BOARD_ADC10) && defined(TELEMETRY_RS485)
+/* P1.1 is UCA0RXD */
+typedef AnalogPin<4> BatteryPin;   /* P1.4/A4 */
+#elif defined(BOARD_ADC10)
+typedef AnalogPin<1> BatteryPin;   /* P1.1/A1 */
+#endif
+
+class ThermoHygrometer
+{
+public:
+    ThermoHygrometer(uint16_t node_id = TELEMETRY_NODE_ID);
+
+    void Init();
+    void Update();
+
+    /* Work left for Update(): main must not sleep */
+    uint8_t pending();
+    /* Deepest low power mode the idle peripherals allow */
+    uint16_t sleep_bits();
+
+    /* Watchdog interval: returns 1 when the CPU must wake up */
+    uint8_t watchdog_tick();
+
+private:
+    /* OLED SSD1306 */
+    SSD1306 my_oled;
+    MainScreen my_screen;
+#ifdef OLED_SECOND_I2C_ADDRESS
+    SSD1306 my_oled2;
+    MainScreen my_screen2;
+#endif
+    Dht22<DhtPin, DhtPowerPin> my_temp_sensor;
+#ifdef BOARD_ADC10
+    Battery<BatteryPin> my_battery;
+#endif
+
+    /* Tasks */
+    void sample();
+#ifdef BOARD_ADC10
+    void battery();
+#endif
+    void telemetry();
+    void display();
+#ifdef TELEMETRY_RS485
+    void bus();
+#endif
+#ifdef SENSOR_POWER_GATED
+    void sensor_power();
+#endif
+
+    void set_clock(uint8_t mhz);
+
+    /* Event bits */
+    enum {
+        EVENT_SAMPLE = 0x01,
+        EVENT_POLL = 0x02,
+    };
+
+    static const uint8_t TASKS = 3
+#ifdef BOARD_ADC10
+                                 + 1
+#endif
+#ifdef TELEMETRY_RS485
+                                 + 1
+#endif
+#ifdef SENSOR_POWER_GATED
+                                 + 1
+#endif
+                                 ;
+    /* Run order. The gated DHT22 warms up while the OLED is refreshed
+     * only because sensor_power comes before display: in a wake-up where
+     * both are due, the sensor is switched on first */
+    static const Scheduler<ThermoHygrometer, TASKS>::Task task_table[TASKS];
+    Scheduler<ThermoHygrometer, TASKS> my_scheduler;
+
+    AdaptiveRate my_rate;
+    /* Settled humidity shown while the DHT22 element catches up */
+    LagEstimator my_humi_lag;
+    /* DHT22 reading corrected for the OLED and board warming */
+    SelfHeating my_heating;
+
+    /* Last readings */
+    telemetry_sample_t my_sample;
+    uint16_t battery_volts;
+
+    uint16_t my_node_id;
+#ifdef TELEMETRY_UART
+    Telemetry my_telemetry;
+#endif
+#ifdef TELEMETRY_RS485
+    BusNode my_bus;
+#endif
+    /* WDT interval counter: sample timestamps */
+    volatile uint32_t wdt_ticks;
+    uint16_t sensor_errors;
+};
+
+#endif /* THERMOHYGROMETER_H_ */
@@ -0,0 +1,225 @@
+/*
+ * cycles.cpp : cycle count of firmware hot paths
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Target program: built with msp430-elf-g++ and run by run_cycles.sh
+ *      in the mspdebug simulator (or on a LaunchPad). Each benchmark runs
+ *      once between two reads of Timer_A clocked by SMCLK = MCLK, so the
+ *      result is in CPU cycles. The stack below the caller is painted
+ *      before the call and scanned after it for the deepest byte used.
+ *
+ *      The 16-bit timer wraps after 4ms at 16MHz. dht_response() takes
+ *      longer and runs with interrupts off, so an overflow count is not
+ *      an option: it is timed with SMCLK / 8 (32ms range, 8 cycle steps).
+ *
+ *      The I2C master is replaced by bench/i2c_null.c, so Refresh() is
+ *      the CPU cost of a band without bus time, and the DHT22 pin
+ *      replays a fixed frame, so dht_response() runs its full decode
+ *      with the protocol delays of OneWire.h.
+ *
+ *      Results stay in bench_results[] (BENCH_x order) and the program
+ *      stops at bench_done(), where run_cycles.sh reads them.
+ */
+
+#include <msp430.h>
+#include <stdint.h>
+
+#include <lib/format.h>
+#include <lib/fixed.h>
+
+#include "SSD1306.h"
+#include "Dht22.h"
+
+/* Bytes below the caller stack pointer checked for use */
+#define BENCH_STACK_PAINT   160
+#define BENCH_PAINT_BYTE    0xA5
+
+/* Benchmarks: same order as BENCHES in run_cycles.sh */
+enum {
+    BENCH_EMPTY,            /* measurement overhead */
+    BENCH_CLEAR,
+    BENCH_SCALED_CHAR_1,
+    BENCH_SCALED_CHAR_2,
+    BENCH_REFRESH,
+    BENCH_DHT22,
+    BENCH_DIGITS,
+    BENCH_FIXED_ADC,        /* ADC10 reading -> Q12 volts -> mV */
+    BENCH_FIXED_TENTHS,     /* tenths -> Q8 -> tenths */
+    BENCH_FIXED_MUL,
+    BENCH_COUNT
+};
+
+/* Timer_A input divider of the benchmarks over 65535 cycles */
+#define BENCH_LONG_DIV      ID_3
+#define BENCH_LONG_SHIFT    3
+
+typedef struct {
+    uint32_t cycles;        /* 0xFFFFFFFF: timer overflow */
+    uint16_t stack;         /* bytes, return address included */
+} bench_result_t;
+
+volatile bench_result_t bench_results[BENCH_COUNT];
+
+/**
+ * DHT22 data pin stand-in: returns the levels OneWire<DQ> polls for a
+ * frame of 60.0 %RH and 23.0 oC. Per bit: low, rising edge, sample,
+ * then high once more for a '1' before the next low.
+ */
+struct BenchDhtPin {
+    static uint8_t phase;
+    static uint8_t bit;
+
+    static void output() { }
+    static void input() { }
+    static void clear() { }
+
+    static uint8_t read();
+    static void rewind() { phase = 0; bit = 0; }
+};
+
+static const uint8_t bench_dht_frame[5] = { 0x02, 0x58, 0x00, 0xE6, 0x40 };
+
+uint8_t BenchDhtPin::phase;
+uint8_t BenchDhtPin::bit;
+
+uint8_t BenchDhtPin::read()
+{
+    uint8_t level;
+
+    /* Presence: low then high */
+    if (phase < 2)
+        return phase++ == 1;
+
+    /* End pulse, then released */
+    if (bit == 40) {
+        if (phase == 2) {
+            phase++;
+            return 0;
+        }
+        return 1;
+    }
+
+    level = (bench_dht_frame[bit >> 3] >> (7 - (bit & 7))) & 1;
+
+    switch (phase++) {
+    case 2:
+        return 0;
+    case 3:
+        return 1;
+    case 4:
+        if (!level)
+            phase = 6;
+        return level;
+    case 5:
+        return 1;
+    default:
+        phase = 2;
+        bit++;
+        return 0;
+    }
+}
+
+static SSD1306 oled(0x3C);
+static Dht22<BenchDhtPin> dht;
+static uint8_t digits[3];
+
+/* Volatile: the fixed-point benchmarks are inline, keep the compiler
+ * from folding them */
+static volatile uint16_t bench_adc = 614;
+static volatile int16_t bench_tenths = 235;
+static volatile int16_t bench_fixed_out;
+static Fixed<8> bench_a, bench_b;
+
+static void bench_empty() { }
+static void bench_clear() { oled.ClearFrameBuffer(); }
+static void bench_scaled_char_1() { oled.WriteScaledChar(32, 0, '8', 1); }
+static void bench_scaled_char_2() { oled.WriteScaledChar(32, 0, '8', 2); }
+static void bench_refresh() { oled.Refresh(SSD1306::LINE_1); }
+static void bench_dht22() { dht.dht_response(); }
+static void bench_digits() { format_digits(235, digits, 3); }
+
+static void bench_fixed_adc()
+{
+    Fixed<12, uint16_t> v = Fixed<12, uint16_t>::from_raw(bench_adc << 2) *
+                            Fixed<12, uint16_t>::constant<33, 10>();
+
+    bench_fixed_out = (int16_t)v.to_scaled<1000>();
+}
+
+static void bench_fixed_tenths()
+{
+    bench_fixed_out = (int16_t)Fixed<8>::from_scaled<10>(bench_tenths).to_scaled<10>();
+}
+
+static void bench_fixed_mul()
+{
+    bench_fixed_out = (bench_a * bench_b).raw;
+}
+
+/**
+ * @brief  Run fn once and keep its cycle count and stack depth.
+ * @param  id: BENCH_x index.
+ *         fn: benchmark.
+ *         div: Timer_A input divider, ID_0 or BENCH_LONG_DIV.
+ *
+ * @retval Nenhum.
+ */
+static void __attribute__((noinline)) bench_run(uint8_t id, void (*fn)(), uint16_t div = ID_0)
+{
+    uint8_t *sp, *p;
+    uint16_t start, stop;
+
+    __asm__ __volatile__ ("mov r1, %0" : "=r"(sp));
+
+    for (p = sp - BENCH_STACK_PAINT; p < sp; p++)
+        *p = BENCH_PAINT_BYTE;
+
+    TACTL = TASSEL_2 | MC_2 | TACLR | div;
+    start = TAR;
+    fn();
+    stop = TAR;
+
+    if (TACTL & TAIFG)
+        bench_results[id].cycles = 0xFFFFFFFF;
+    else
+        bench_results[id].cycles = (uint32_t)(uint16_t)(stop - start) << (div == ID_0 ? 0 : BENCH_LONG_SHIFT);
+
+    for (p = sp - BENCH_STACK_PAINT; p < sp && *p == BENCH_PAINT_BYTE; p++);
+    bench_results[id].stack = sp - p;
+}
+
+/* Breakpoint of run_cycles.sh */
+extern "C" void __attribute__((noinline)) bench_done()
+{
+    __no_operation();
+}
+
+int main()
+{
+    WDTCTL = WDTPW | WDTHOLD;
+
+    DCOCTL = 0;
+    BCSCTL1 = CALBC1_16MHZ;
+    DCOCTL = CALDCO_16MHZ;
+
+    bench_run(BENCH_EMPTY, bench_empty);
+    bench_run(BENCH_CLEAR, bench_clear);
+    bench_run(BENCH_SCALED_CHAR_1, bench_scaled_char_1);
+    bench_run(BENCH_SCALED_CHAR_2, bench_scaled_char_2);
+    bench_run(BENCH_REFRESH, bench_refresh);
+    BenchDhtPin::rewind();
+    bench_run(BENCH_DHT22, bench_dht22, BENCH_LONG_DIV);
+    bench_run(BENCH_DIGITS, bench_digits);
+    bench_a = Fixed<8>::constant<235, 10>();
+    bench_b = Fixed<8>::constant<-3, 2>();
+    bench_run(BENCH_FIXED_ADC, bench_fixed_adc);
+    bench_run(BENCH_FIXED_TENTHS, bench_fixed_tenths);
+    bench_run(BENCH_FIXED_MUL, bench_fixed_mul);
+
+    bench_done();
+
+    while (1)
+        __bis_SR_register(LPM4_bits);
+}
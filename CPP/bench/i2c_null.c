@@ -0,0 +1,41 @@
+/*
+ * i2c_null.c : I2C master without bus for cycles.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Transfers complete at once: benchmarks see only the CPU work of
+ *      their caller. Bytes written are counted.
+ */
+
+#include <lib/i2c_master_f247_g2xxx.h>
+
+volatile uint16_t bench_i2c_bytes;
+
+i2c_mode i2c_master_write_reg(uint8_t dev_addr, uint8_t reg_addr, uint8_t *reg_data, uint8_t count)
+{
+    (void)dev_addr;
+    (void)reg_addr;
+    (void)reg_data;
+
+    bench_i2c_bytes += count + 1;
+
+    return IDLE_MODE;
+}
+
+void i2c_queue_write(i2c_transaction_t *t)
+{
+    bench_i2c_bytes += t->count + 1;
+    t->state = IDLE_MODE;
+}
+
+uint8_t i2c_queue_done(const i2c_transaction_t *t)
+{
+    (void)t;
+
+    return 1;
+}
+
+void i2c_flush()
+{
+}
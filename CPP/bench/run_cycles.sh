@@ -0,0 +1,138 @@
+#!/bin/sh
+#
+# run_cycles.sh : cycle benchmarks of firmware hot paths
+#
+#  Created on: Oct 19, 2026
+#      Author: xtarke
+#
+#      Builds cycles.cpp with msp430-elf-gcc, runs it in the mspdebug
+#      simulator and prints, per benchmark, CPU cycles (measurement
+#      overhead removed), stack depth and code size of the function under
+#      test. It only reports: no reference run with msp430-elf-gcc and
+#      mspdebug has been recorded, so there are no numbers to compare
+#      against.
+#
+#      The firmware itself (main.cpp and the sources it links) is built
+#      first and the script fails if the ELF links a 32-bit division of
+#      libgcc: the hot paths use tables and reciprocals computed at
+#      compile time, and a division slipping in costs hundreds of cycles
+#      per call on a core without divider.
+#
+#          CPP/bench/run_cycles.sh
+#
+#      Environment:
+#          MCU        msp430g2553 (default) or msp430f247
+#          CROSS      toolchain prefix, default msp430-elf-
+#          SUPPORT    directory of the TI device headers and linker scripts
+#          DRIVER     mspdebug driver: sim (default) or rf2500 for a LaunchPad
+#
+#      The simulator runs every clock from the instruction cycle count, so
+#      Timer_A on SMCLK reads CPU cycles as on the device at any DCO
+#      setting.
+
+set -e
+
+BENCH_DIR=$(cd "$(dirname "$0")" && pwd)
+SRC_DIR=$(dirname "$BENCH_DIR")
+MCU=${MCU:-msp430g2553}
+CROSS=${CROSS:-msp430-elf-}
+DRIVER=${DRIVER:-sim}
+OUT=${OUT:-${TMPDIR:-/tmp}/th-cycles-$MCU}
+
+# name: symbol of the function under test, as printed by nm -C.
+# Order of the BENCH_x enum of cycles.cpp.
+BENCHES="empty:-
+clear:SSD1306::ClearFrameBuffer()
+scaled_char_1:SSD1306::WriteScaledChar(short,_short,_char,_unsigned_char)
+scaled_char_2:SSD1306::WriteScaledChar(short,_short,_char,_unsigned_char)
+refresh:SSD1306::Refresh(SSD1306::oled_partition_t)
+dht22:Dht22<BenchDhtPin,_NoPin>::dht_response()
+digits:format_digits
+fixed_adc:bench_fixed_adc()
+fixed_tenths:bench_fixed_tenths()
+fixed_mul:bench_fixed_mul()"
+
+FLAGS="-mmcu=$MCU -Os -g -ffunction-sections -fdata-sections -I $SRC_DIR"
+if [ -n "$SUPPORT" ]; then
+    FLAGS="$FLAGS -I $SUPPORT -L $SUPPORT"
+fi
+
+mkdir -p "$OUT"
+
+# Firmware: no 32-bit division routine linked
+${CROSS}g++ $FLAGS -std=c++14 -fno-exceptions -fno-rtti -fno-threadsafe-statics \
+    -Wl,--gc-sections -o "$OUT/firmware.elf" \
+    "$SRC_DIR/main.cpp" "$SRC_DIR/ThermoHygrometer.cpp" "$SRC_DIR/SSD1306.cpp" \
+    "$SRC_DIR/MainScreen.cpp" "$SRC_DIR/Telemetry.cpp" "$SRC_DIR/BusNode.cpp" \
+    "$SRC_DIR/AdaptiveRate.cpp" "$SRC_DIR/LagEstimator.cpp" "$SRC_DIR/Comfort.cpp" \
+    "$SRC_DIR/SelfHeating.cpp" -x c "$SRC_DIR"/lib/*.c
+
+DIVISIONS=$(${CROSS}nm "$OUT/firmware.elf" | \
+    grep -E ' (__u?divsi3|__u?modsi3|__mspabi_(divli|divul|remli|remul))$' || true)
+if [ -n "$DIVISIONS" ]; then
+    echo "firmware links a 32-bit division:"
+    echo "$DIVISIONS"
+    exit 1
+fi
+
+${CROSS}gcc $FLAGS -c "$SRC_DIR/lib/format.c" -o "$OUT/format.o"
+${CROSS}gcc $FLAGS -c "$BENCH_DIR/i2c_null.c" -o "$OUT/i2c_null.o"
+${CROSS}g++ $FLAGS -std=c++14 -fno-exceptions -fno-rtti -fno-threadsafe-statics \
+    -Wl,--gc-sections -o "$OUT/cycles.elf" \
+    "$BENCH_DIR/cycles.cpp" "$SRC_DIR/SSD1306.cpp" "$OUT/format.o" "$OUT/i2c_null.o"
+
+COUNT=$(echo "$BENCHES" | wc -l)
+
+if [ "$DRIVER" = sim ]; then
+    set -- "simio add timer ta0" "simio config ta0 base 0x0160"
+else
+    set --
+fi
+
+mspdebug -q "$DRIVER" "prog $OUT/cycles.elf" "$@" "setbreak bench_done" "run" \
+    "md bench_results $((COUNT * 6))" > "$OUT/md.txt"
+
+${CROSS}nm -C -S "$OUT/cycles.elf" | sed 's/ /_/4g' > "$OUT/nm.txt"
+
+# md lines: "    addr: b0 b1 ... |ascii|"; results are little endian u32
+# cycles and u16 stack
+awk -v benches="$BENCHES" -v nm="$OUT/nm.txt" '
+function hex(s,    v, i) {
+    v = 0
+    s = tolower(s)
+    sub(/^0x/, "", s)
+    for (i = 1; i <= length(s); i++)
+        v = v * 16 + index("0123456789abcdef", substr(s, i, 1)) - 1
+    return v
+}
+BEGIN {
+    n = split(benches, list, "\n")
+    for (i = 1; i <= n; i++) {
+        split(list[i], f, ":")
+        name[i] = f[1]
+        symbol[i] = substr(list[i], length(f[1]) + 2)
+    }
+    while ((getline line < nm) > 0) {
+        split(line, f, " ")
+        if (f[3] ~ /^[tTwW]$/)
+            size[f[4]] = hex(f[2])
+    }
+}
+$1 ~ /^(0x)?[0-9a-fA-F]+:$/ {
+    for (i = 2; i <= NF && $i !~ /^\|/; i++)
+        bytes[count++] = hex($i)
+}
+END {
+    for (i = 1; i <= n; i++) {
+        b = (i - 1) * 6
+        cycles[i] = bytes[b] + bytes[b + 1] * 256 + bytes[b + 2] * 65536 + bytes[b + 3] * 16777216
+        stack[i] = bytes[b + 4] + bytes[b + 5] * 256
+    }
+
+    printf "%-14s %8s %6s %6s\n", "benchmark", "cycles", "stack", "size"
+    for (i = 2; i <= n; i++) {
+        c = cycles[i] == 4294967295 ? -1 : cycles[i] - cycles[1]
+        s = symbol[i] in size ? size[symbol[i]] : 0
+        printf "%-14s %8s %6d %6d\n", name[i], c < 0 ? "overflow" : c, stack[i], s
+    }
+}' "$OUT/md.txt"
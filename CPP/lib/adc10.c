@@ -0,0 +1,180 @@
+/*
+ *  adc10.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      - Conversões do ADC10 por software, um canal por vez.
+ *      - ADC e referência ligados apenas durante adc10_read(): a CPU
+ *        fica em LPM0 até a IRQ de fim de conversão.
+ *      - Sensor interno de temperatura (INCH_10) com a referência de
+ *        1,5V e a calibração de fábrica do segmento A (TLV).
+ */
+
+/* System includes */
+#include <lib/adc10.h>
+#include <msp430.h>
+#include <stdint.h>
+
+#if !defined(__MSP430F247__) && !defined(__MSP430G2553__)
+    #error "Library no supported/validated in this device."
+#endif
+
+/* F247: ADC12, sem ADC10 e sem a sua calibração na TLV (0x10E2 e
+ * 0x10E4). Nada é compilado: ThermoHygrometer.h não lê a bateria nem a
+ * temperatura do die nesse dispositivo */
+#if defined(__MSP430G2553__)
+
+/* TLV: leituras do sensor de temperatura a 30 e 85oC com a referência
+ * de 1,5V. Apagada: 0xFFFF */
+#ifndef ADC10_CAL_15T30
+#define ADC10_CAL_15T30         (*(const uint16_t *)0x10E2)
+#define ADC10_CAL_15T85         (*(const uint16_t *)0x10E4)
+#endif
+
+/* Valores típicos do datasheet: 0,986V + 3,55mV/oC, referência de 1,5V */
+#define ADC10_TYP_15T30         745
+#define ADC10_TYP_15T85         878
+
+static volatile uint8_t adc_busy;
+
+/* Reta do sensor de temperatura para somas de adc10_temperature_init():
+ * soma a 30oC e décimos de oC por unidade da soma em Q16 */
+static uint16_t temp_offset;
+static int32_t temp_slope;
+
+/**
+  * @brief  Habilita entradas analógicas (ADC10AE0).
+  *
+  * @param  ae_mask: bits dos canais A0 a A7.
+  *
+  * @retval Nenhum.
+  */
+void adc10_enable_inputs(uint8_t ae_mask)
+{
+    ADC10AE0 |= ae_mask;
+}
+
+/**
+  * @brief  Soma de count conversões de um canal. O ADC e a referência
+  *         são desligados no fim.
+  *
+  * @param  inch: canal, bits INCH_x de ADC10CTL1.
+  *         ref: ADC10_REF_VCC ou ADC10_REF_1V5. Com a referência
+  *              interna o tempo de amostragem é o maior (sensor de
+  *              temperatura: 30us).
+  *         count: conversões, até 64.
+  *
+  * @retval Soma das leituras de 10 bits.
+  */
+uint16_t adc10_read(uint16_t inch, uint8_t ref, uint8_t count)
+{
+    uint16_t sum = 0;
+
+    if (ref == ADC10_REF_1V5) {
+        /* 64 x ADC10CLK / 4: ~50us de amostragem */
+        ADC10CTL0 = SREF_1 + ADC10SHT_3 + REFON + ADC10ON + ADC10IE;
+        ADC10CTL1 = inch + ADC10DIV_3;
+        __delay_cycles(CYCLES_FOR_US(ADC10_REF_SETTLE_US));
+    }
+    else {
+        /* 16 x ADC10CLK */
+        ADC10CTL0 = SREF_0 + ADC10SHT_2 + ADC10ON + ADC10IE;
+        ADC10CTL1 = inch;
+    }
+
+    while (count--) {
+        adc_busy = 1;
+        ADC10CTL0 |= ENC + ADC10SC;
+
+        /* Testa e dorme sem janela para a IRQ */
+        while (1) {
+            __disable_interrupt();
+            if (!adc_busy)
+                break;
+            __bis_SR_register(CPUOFF + GIE);
+        }
+        __enable_interrupt();
+
+        sum += ADC10MEM;
+        ADC10CTL0 &= ~ENC;
+    }
+
+    /* ADC e referência desligados */
+    ADC10CTL0 = 0;
+
+    return sum;
+}
+
+/**
+  * @brief  Calibra o sensor interno de temperatura uma vez: reta entre os
+  *         pontos de 30 e 85oC da TLV, ou os típicos se foi apagada,
+  *         para somas de count leituras. A única divisão fica aqui,
+  *         por subtrações sucessivas: sem a rotina de 32 bits da libgcc.
+  *
+  * @param  count: conversões das somas passadas a adc10_temperature().
+  *
+  * @retval Nenhum.
+  */
+void adc10_temperature_init(uint8_t count)
+{
+    uint16_t t30 = ADC10_CAL_15T30;
+    uint16_t t85 = ADC10_CAL_15T85;
+    uint32_t span;
+    uint32_t num = (550UL << 16);
+    uint32_t rem = 0;
+    uint32_t quot = 0;
+    uint8_t i;
+
+    if (t30 == 0xFFFF || t85 == 0xFFFF || t85 <= t30) {
+        t30 = ADC10_TYP_15T30;
+        t85 = ADC10_TYP_15T85;
+    }
+
+    span = (uint32_t)(t85 - t30) * count;
+    temp_offset = t30 * count;
+    num += span >> 1;
+
+    /* quot = num / span, um bit por passo */
+    for (i = 0; i < 32; i++) {
+        rem = (rem << 1) | (num >> 31);
+        num <<= 1;
+        quot <<= 1;
+        if (rem >= span) {
+            rem -= span;
+            quot |= 1;
+        }
+    }
+    temp_slope = (int32_t)quot;
+}
+
+/**
+  * @brief  Temperatura do die a partir da soma de leituras do sensor
+  *         interno com ADC10_REF_1V5: uma multiplicação pela inclinação
+  *         de adc10_temperature_init() e um deslocamento.
+  *
+  * @param  sum: soma de adc10_read(ADC10_INCH_TEMP, ADC10_REF_1V5, count),
+  *         count de adc10_temperature_init().
+  *
+  * @retval Décimos de oC.
+  */
+int16_t adc10_temperature(uint16_t sum)
+{
+    return (int16_t)(300 + ((((int32_t)sum - temp_offset) * temp_slope + 0x8000L) >> 16));
+}
+
+/* ISR do ADC10. Executada quando a conversão terminar */
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=ADC10_VECTOR
+__interrupt void ADC10_ISR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(ADC10_VECTOR))) ADC10_ISR (void)
+#else
+#error Compiler not supported!
+#endif
+{
+    adc_busy = 0;
+    __bic_SR_register_on_exit(CPUOFF);
+}
+
+#endif /* __MSP430G2553__ */
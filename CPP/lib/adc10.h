@@ -0,0 +1,51 @@
+/*
+ * adc10.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      ADC10 conversions shared by the drivers. The ADC and its reference
+ *      are powered only inside adc10_read(), with the CPU in LPM0 until
+ *      each conversion ends, so channels with different references can
+ *      be read in the same wake-up at no standby cost. G2553 only: the
+ *      F247 has an ADC12, lib/adc10.c compiles to nothing there.
+ *
+ *          adc10_enable_inputs(BatteryPin::ae_mask);
+ *          raw = adc10_read(BatteryPin::inch, ADC10_REF_VCC, 1);
+ *
+ *          adc10_temperature_init(4);              once
+ *          sum = adc10_read(ADC10_INCH_TEMP, ADC10_REF_1V5, 4);
+ *          tenths = adc10_temperature(sum);        die temperature
+ */
+
+#ifndef LIB_ADC10_H_
+#define LIB_ADC10_H_
+
+#include <stdint.h>
+
+#include <lib/clock.h>
+
+/* References of adc10_read() */
+#define ADC10_REF_VCC           0
+#define ADC10_REF_1V5           1
+
+/* Internal temperature sensor: INCH_10 */
+#define ADC10_INCH_TEMP         (10u << 12)
+
+/* Internal reference settling time: datasheet, REFON to conversion */
+#define ADC10_REF_SETTLE_US     30
+
+#ifndef EXPORT_C
+#ifdef __cplusplus
+    #define EXPORT_C extern "C"
+#else
+    #define EXPORT_C
+#endif
+#endif
+
+EXPORT_C void adc10_enable_inputs(uint8_t ae_mask);
+EXPORT_C uint16_t adc10_read(uint16_t inch, uint8_t ref, uint8_t count);
+EXPORT_C void adc10_temperature_init(uint8_t count);
+EXPORT_C int16_t adc10_temperature(uint16_t sum);
+
+#endif /* LIB_ADC10_H_ */
@@ -0,0 +1,81 @@
+/*
+ *  clock.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      - Troca do MCLK/SMCLK em tempo de execução entre as calibrações
+ *        do DCO gravadas na flash (segmento A), até F_CPU.
+ *      - Baseado em msp430g2xxx3_dco_calib.c da Texas Instruments.
+ */
+
+/* System includes */
+#include <lib/clock.h>
+#include <msp430.h>
+#include <stdint.h>
+
+static uint8_t mclk_mhz = CLOCK_MHZ_FAST;
+
+/**
+  * @brief  Configura o DCO com a calibração de mhz. Periféricos com
+  *         SMCLK devem ser reconfigurados depois (uart_update_clock()).
+  *
+  * @param  mhz: 1, 8, 12 ou 16, até CLOCK_MHZ_FAST.
+  *
+  * @retval 1 se o clock mudou, 0 se a frequência não é suportada ou a
+  *         calibração foi apagada.
+  */
+uint8_t clock_set_mhz(uint8_t mhz)
+{
+    uint8_t bcsctl1, dcoctl;
+
+    if (mhz > CLOCK_MHZ_FAST)
+        return 0;
+
+    switch (mhz) {
+    case 1:
+        bcsctl1 = CALBC1_1MHZ;
+        dcoctl = CALDCO_1MHZ;
+        break;
+    case 8:
+        bcsctl1 = CALBC1_8MHZ;
+        dcoctl = CALDCO_8MHZ;
+        break;
+    case 12:
+        bcsctl1 = CALBC1_12MHZ;
+        dcoctl = CALDCO_12MHZ;
+        break;
+    case 16:
+        bcsctl1 = CALBC1_16MHZ;
+        dcoctl = CALDCO_16MHZ;
+        break;
+    default:
+        return 0;
+    }
+
+    /* Calibração apagada */
+    if (bcsctl1 == 0xFF)
+        return 0;
+
+    /* DCOx = 0 antes de trocar o RSEL: evita passar por uma
+     * frequência acima da máxima no meio da troca */
+    DCOCTL = 0;
+    BCSCTL1 = bcsctl1;
+    DCOCTL = dcoctl;
+
+    mclk_mhz = mhz;
+
+    return 1;
+}
+
+/**
+  * @brief  Frequência atual do MCLK e do SMCLK.
+  *
+  * @param  Nenhum
+  *
+  * @retval MHz.
+  */
+uint8_t clock_get_mhz()
+{
+    return mclk_mhz;
+}
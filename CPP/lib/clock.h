@@ -0,0 +1,78 @@
+/*
+ * clock.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      MCLK frequency and microsecond timing computed at compile time.
+ *      F_CPU is the fastest clock of the build and every driver derives
+ *      its delays from it, so the build can drop to 1 or 8MHz with
+ *      -DF_CPU=8000000UL. SMCLK = MCLK.
+ *
+ *          delay_us<480>();                    C++ drivers
+ *          __delay_cycles(CYCLES_FOR_US(5));   C library
+ *
+ *      At run time clock_set_mhz() switches between the DCO calibrations
+ *      up to F_CPU. Peripherals clocked by SMCLK (I2C, UART, timer delay)
+ *      follow clock_get_mhz(); busy waits do not: bit-banged drivers must
+ *      run at CLOCK_MHZ_FAST.
+ */
+
+#ifndef LIB_CLOCK_H_
+#define LIB_CLOCK_H_
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#define F_CPU                   16000000UL
+#endif
+
+/* Only the frequencies with DCO calibration data in flash */
+#if F_CPU != 1000000UL && F_CPU != 8000000UL && F_CPU != 12000000UL && F_CPU != 16000000UL
+    #error "F_CPU must be 1, 8, 12 or 16MHz"
+#endif
+
+#define CYCLES_PER_US           (F_CPU / 1000000UL)
+#define CYCLES_FOR_US(us)       ((uint32_t)(us) * CYCLES_PER_US)
+
+/* Run time MCLK: full speed and lowest calibration */
+#define CLOCK_MHZ_FAST          (F_CPU / 1000000UL)
+#define CLOCK_MHZ_SLOW          1
+
+#ifndef EXPORT_C
+#ifdef __cplusplus
+    #define EXPORT_C extern "C"
+#else
+    #define EXPORT_C
+#endif
+#endif
+
+EXPORT_C uint8_t clock_set_mhz(uint8_t mhz);
+EXPORT_C uint8_t clock_get_mhz();
+
+#ifdef __cplusplus
+
+#include <msp430.h>
+
+constexpr uint32_t cycles_for_us(uint32_t us)
+{
+    return us * CYCLES_PER_US;
+}
+
+/**
+ * @brief  Busy wait of US microseconds at F_CPU. Interrupts stretch it.
+ *         Call overhead is not subtracted: a few cycles, i.e. several
+ *         microseconds at 1MHz.
+ */
+template <uint32_t US>
+inline void delay_us()
+{
+    static constexpr uint32_t cycles = cycles_for_us(US);
+
+    static_assert(cycles > 0, "delay_us<0>");
+    __delay_cycles(cycles);
+}
+
+#endif /* __cplusplus */
+
+#endif /* LIB_CLOCK_H_ */
@@ -0,0 +1,27 @@
+/*
+ * crc.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      CRC routines used by the bus and sensor drivers.
+ */
+
+#ifndef LIB_CRC_H_
+#define LIB_CRC_H_
+
+#include <stdint.h>
+
+#ifndef EXPORT_C
+#ifdef __cplusplus
+    #define EXPORT_C extern "C"
+#else
+    #define EXPORT_C
+#endif
+#endif
+
+EXPORT_C uint8_t crc8_maxim(const uint8_t *data, uint8_t count);
+EXPORT_C uint8_t crc8_sensirion(const uint8_t *data, uint8_t count);
+EXPORT_C uint16_t crc16_ccitt(const uint8_t *data, uint8_t count);
+
+#endif /* LIB_CRC_H_ */
@@ -0,0 +1,193 @@
+/*
+ * fixed.h : Q-format fixed-point numbers
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Fixed<FRAC, T> holds value * 2^FRAC in a 16-bit integer T (int16_t
+ *      or uint16_t). Sums and products saturate at the limits of T instead
+ *      of wrapping. Scale factors are folded at compile time, so a
+ *      conversion is one multiply and a shift: the G2553 has neither a
+ *      multiplier nor a divider, and this keeps the float and division
+ *      routines out of the image.
+ *
+ *          typedef Fixed<10, uint16_t> Volts;
+ *
+ *          Volts v = Volts::from_raw(ADC10MEM) * Volts::constant<33, 10>();
+ *          v.to_scaled<1000>()                 mV
+ *          v.to_digits<10>(digits, 2)          3.3 -> { 3, 3 }
+ *          Fixed<8>::from_scaled<10>(235)      23.5 from tenths
+ *
+ *      There is no division operator: divide by constant<1, N>() instead.
+ */
+
+#ifndef LIB_FIXED_H_
+#define LIB_FIXED_H_
+
+#include <stdint.h>
+
+#include <lib/format.h>
+
+/* Intermediate type and saturation of each storage type */
+template <class T>
+struct FixedTraits;
+
+template <>
+struct FixedTraits<int16_t> {
+    typedef int32_t wide_t;
+
+    static inline int16_t saturate(int32_t v) {
+        return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (int16_t)v;
+    }
+    static inline int32_t sub(int16_t a, int16_t b) { return (int32_t)a - b; }
+};
+
+template <>
+struct FixedTraits<uint16_t> {
+    typedef uint32_t wide_t;
+
+    static inline uint16_t saturate(int32_t v) {
+        return v > UINT16_MAX ? UINT16_MAX : v < 0 ? 0 : (uint16_t)v;
+    }
+    static inline uint16_t saturate(uint32_t v) {
+        return v > UINT16_MAX ? UINT16_MAX : (uint16_t)v;
+    }
+    /* Below zero: 0 */
+    static inline uint32_t sub(uint16_t a, uint16_t b) { return a > b ? a - b : 0; }
+};
+
+/* round(2^BITS / DEN) */
+constexpr uint32_t fixed_reciprocal(uint8_t bits, uint32_t den)
+{
+    return (((uint32_t)1 << bits) + den / 2) / den;
+}
+
+/* Extra bits of a reciprocal that still fits 16 bits: precision of
+ * from_scaled() */
+constexpr uint8_t fixed_extra_bits(uint8_t frac, uint32_t den)
+{
+    uint8_t bits = 0;
+
+    while (bits < 16 && fixed_reciprocal(frac + bits + 1, den) <= UINT16_MAX)
+        bits++;
+
+    return bits;
+}
+
+/* v * 2^n, saturated; n < 0: rounded down */
+constexpr int32_t fixed_shift(int32_t v, int8_t n)
+{
+    return n < 0 ? v >> -n :
+           v > (INT32_MAX >> n) ? INT32_MAX :
+           v < (INT32_MIN >> n) ? INT32_MIN : v * ((int32_t)1 << n);
+}
+
+template <uint8_t FRAC, class T = int16_t>
+class Fixed
+{
+    static_assert(sizeof(T) == 2, "16-bit storage");
+    static_assert(FRAC <= 15, "fraction bits");
+
+public:
+    typedef typename FixedTraits<T>::wide_t wide_t;
+
+    T raw;
+
+    static constexpr int32_t unit() { return (int32_t)1 << FRAC; }
+
+    static inline Fixed from_raw(T value) {
+        Fixed f;
+        f.raw = value;
+        return f;
+    }
+
+    static inline Fixed from_int(int16_t value) {
+        return from_raw(FixedTraits<T>::saturate(fixed_shift(value, FRAC)));
+    }
+
+    /**
+     * @brief  NUM / DEN rounded at compile time.
+     */
+    template <int32_t NUM, int32_t DEN = 1>
+    static inline Fixed constant() {
+        static constexpr int32_t value =
+            (NUM * unit() + (NUM < 0 ? -DEN / 2 : DEN / 2)) / DEN;
+
+        static_assert(DEN > 0, "positive denominator");
+        static_assert((T)value == value, "constant out of range");
+
+        return from_raw((T)value);
+    }
+
+    /**
+     * @brief  value / DEN rounded half up, e.g. tenths with DEN = 10:
+     *         multiply by a reciprocal folded at compile time. The 16-bit
+     *         reciprocal can be one LSB off: the remainder, one multiply
+     *         by the constant DEN, corrects it.
+     */
+    template <uint32_t DEN>
+    static inline Fixed from_scaled(int16_t value) {
+        static constexpr uint8_t extra = fixed_extra_bits(FRAC, DEN);
+        static constexpr int32_t reciprocal = fixed_reciprocal(FRAC + extra, DEN);
+        int32_t q, r;
+
+        static_assert(DEN > 0, "positive denominator");
+        static_assert(DEN <= INT16_MAX, "remainder range");
+
+        q = ((int32_t)value * reciprocal + (((int32_t)1 << extra) >> 1)) >> extra;
+        r = (int32_t)value * unit() - q * (int32_t)DEN;
+        if (2 * r >= (int32_t)DEN)
+            q++;
+        else if (2 * r < -(int32_t)DEN)
+            q--;
+
+        return from_raw(FixedTraits<T>::saturate(q));
+    }
+
+    /**
+     * @brief  round(value * SCALE), e.g. SCALE = 10 for tenths.
+     */
+    template <uint16_t SCALE>
+    inline wide_t to_scaled() const {
+        return ((wide_t)raw * SCALE + (unit() >> 1)) >> FRAC;
+    }
+
+    inline int16_t to_int() const { return (int16_t)to_scaled<1>(); }
+
+    /**
+     * @brief  Display digits of round(value * SCALE), which must be
+     *         positive: format_digits().
+     */
+    template <uint16_t SCALE>
+    inline void to_digits(uint8_t *digits, uint8_t count) const {
+        format_digits((uint16_t)to_scaled<SCALE>(), digits, count);
+    }
+
+    inline Fixed operator+(Fixed b) const {
+        return from_raw(FixedTraits<T>::saturate((wide_t)raw + b.raw));
+    }
+
+    inline Fixed operator-(Fixed b) const {
+        return from_raw(FixedTraits<T>::saturate(FixedTraits<T>::sub(raw, b.raw)));
+    }
+
+    inline Fixed operator*(Fixed b) const {
+        return from_raw(FixedTraits<T>::saturate(((wide_t)raw * b.raw) >> FRAC));
+    }
+
+    /* Other format: shift with saturation */
+    template <uint8_t F2, class T2>
+    inline Fixed<F2, T2> convert() const {
+        return Fixed<F2, T2>::from_raw(FixedTraits<T2>::saturate(
+            fixed_shift(raw, (int8_t)F2 - (int8_t)FRAC)));
+    }
+
+    inline bool operator<(Fixed b) const { return raw < b.raw; }
+    inline bool operator>(Fixed b) const { return raw > b.raw; }
+    inline bool operator<=(Fixed b) const { return raw <= b.raw; }
+    inline bool operator>=(Fixed b) const { return raw >= b.raw; }
+    inline bool operator==(Fixed b) const { return raw == b.raw; }
+    inline bool operator!=(Fixed b) const { return raw != b.raw; }
+};
+
+#endif /* LIB_FIXED_H_ */
@@ -0,0 +1,60 @@
+/*
+ * format.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <lib/format.h>
+
+/* Dígitos de um uint16_t */
+#define FORMAT_MAX_DIGITS   5
+
+static const uint16_t powers_of_ten[FORMAT_MAX_DIGITS] = { 1, 10, 100, 1000, 10000 };
+
+/**
+ * @brief  Separa os dígitos decimais menos significativos de um valor.
+ *         Por subtrações sucessivas: o G2553 não tem divisor e a rotina
+ *         de divisão genérica custa centenas de ciclos por dígito.
+ * @param  value: valor a converter.
+ *         digits: vetor de saída, dígito mais significativo primeiro.
+ *         count: número de dígitos.
+ *
+ * @retval Nenhum.
+ */
+void format_digits(uint16_t value, uint8_t *digits, uint8_t count)
+{
+    uint8_t i, d;
+
+    for (; count > FORMAT_MAX_DIGITS; count--)
+        *digits++ = 0;
+
+    for (i = FORMAT_MAX_DIGITS; i > 0; i--) {
+        d = 0;
+        while (value >= powers_of_ten[i - 1]) {
+            value -= powers_of_ten[i - 1];
+            d++;
+        }
+
+        /* Dígitos acima de count são descartados */
+        if (i <= count)
+            *digits++ = d;
+    }
+}
+
+/**
+ * @brief  Dígitos do módulo de um valor com sinal: temperaturas abaixo
+ *         de 0oC.
+ * @param  value: valor a converter.
+ *         digits: vetor de saída, dígito mais significativo primeiro.
+ *         count: número de dígitos.
+ *
+ * @retval 1 se o valor é negativo.
+ */
+uint8_t format_digits_signed(int16_t value, uint8_t *digits, uint8_t count)
+{
+    /* -32768: o módulo cabe em uint16_t */
+    format_digits(value < 0 ? (uint16_t)(-(int32_t)value) : (uint16_t)value, digits, count);
+
+    return value < 0;
+}
@@ -0,0 +1,26 @@
+/*
+ * format.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Number to display digit conversion.
+ */
+
+#ifndef LIB_FORMAT_H_
+#define LIB_FORMAT_H_
+
+#include <stdint.h>
+
+#ifndef EXPORT_C
+#ifdef __cplusplus
+    #define EXPORT_C extern "C"
+#else
+    #define EXPORT_C
+#endif
+#endif
+
+EXPORT_C void format_digits(uint16_t value, uint8_t *digits, uint8_t count);
+EXPORT_C uint8_t format_digits_signed(int16_t value, uint8_t *digits, uint8_t count);
+
+#endif /* LIB_FORMAT_H_ */
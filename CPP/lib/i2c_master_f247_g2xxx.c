@@ -9,6 +9,10 @@
  *      - Biblioteca de comunicação I2C em modo Master
  *      - Baseado em msp430g2xx3_usci_i2c_standard_master.c de
  *      Nima Eskandari -- Texas Instruments Inc.
+ *      - Escritas enfileiradas (i2c_queue_write()): a IRQ encadeia as
+ *      transações da fila enquanto a CPU segue com outras tarefas; entre
+ *      duas delas o Timer0_A aguarda a condição de STOP. As funções
+ *      bloqueantes esperam a fila esvaziar (i2c_flush()).
  *
  *                          .   .
  *                         /|\ /|\
@@ -29,16 +33,74 @@
 #include <stdlib.h>
 
 /* Project includes */
+#include <lib/timer_delay.h>
 
 #if !defined(__MSP430F247__) && !defined(__MSP430G2553__)
     #error "Library no supported/validated in this device."
 #endif
 
+/* SDA/SCL as GPIO for bus recovery and Timer0_A for transaction timeout */
+#if defined(__MSP430F247__)
+    #define I2C_PORT_IN     P3IN
+    #define I2C_PORT_OUT    P3OUT
+    #define I2C_PORT_DIR    P3DIR
+    #define I2C_PORT_SEL    P3SEL
+    #define I2C_SDA         BIT1
+    #define I2C_SCL         BIT2
+
+    #define I2C_TIMER_CTL   TACTL
+    #define I2C_TIMER_CCTL0 TACCTL0
+    #define I2C_TIMER_CCR0  TACCR0
+    #define I2C_TIMER_VECTOR TIMERA0_VECTOR
+#endif
+
+#if defined(__MSP430G2553__)
+    #define I2C_PORT_IN     P1IN
+    #define I2C_PORT_OUT    P1OUT
+    #define I2C_PORT_DIR    P1DIR
+    #define I2C_PORT_SEL    P1SEL
+    #define I2C_PORT_SEL2   P1SEL2
+    #define I2C_SDA         BIT7
+    #define I2C_SCL         BIT6
+
+    #define I2C_TIMER_CTL   TA0CTL
+    #define I2C_TIMER_CCTL0 TA0CCTL0
+    #define I2C_TIMER_CCR0  TA0CCR0
+    #define I2C_TIMER_VECTOR TIMER0_A0_VECTOR
+#endif
+
+/* SMCLK/8 ticks in 30ms per MHz of SMCLK: 30ms covers a 255 byte
+ * transfer at 100kHz */
+#define I2C_TIMEOUT_TICKS_PER_MHZ   3750
+/* fSCL = SMCLK / UCB0BR = 100kHz */
+#define I2C_SCL_DIVIDER_PER_MHZ     10
+/* Busy waits, timed for F_CPU: longer, still bounded, at a lower clock.
+ * Half SCL period at 100kHz for bus recovery: 5us */
+#define I2C_HALF_SCL_CYCLES CYCLES_FOR_US(5)
+/* Busy wait limit for start condition, 4 cycles per loop: ~1ms */
+#define I2C_STT_WAIT_LOOPS  (CYCLES_FOR_US(1000) / 4)
+/* Stop condition before the next queued transaction: the last byte is
+ * still being shifted out when it is requested. Timer0_A polls it every
+ * ~100us (SMCLK/8 ticks per MHz), the rest of the queue fails after ~1ms */
+#define I2C_STOP_TICKS_PER_MHZ      13
+#define I2C_STOP_POLLS              10
+
+/* Retries after a NACK or timeout, first backoff in ms (doubled each retry) */
+#define I2C_MAX_RETRIES     2
+#define I2C_BACKOFF_MS      1
+
 struct i2c_status_t {
     /* Used to track the state of the software state machine*/
     i2c_mode state;
-    /* Device Addr */
+    /* First state of the transaction: TX_REG_ADDRESS_MODE or RX_DATA_MODE */
+    i2c_mode start_state;
+    /* Slave address */
+    uint8_t slave_addr;
+    /* Register address */
     uint8_t device_addr;
+    /* Requested sizes: kept for retries */
+    uint8_t rx_count;
+    uint8_t tx_count;
     /* RX: Pointers and index */
     uint8_t *data_to_receive;
     uint8_t rx_byte_count;
@@ -52,6 +114,22 @@ struct i2c_status_t {
 /* Estado do módulo I2C */
 volatile struct i2c_status_t i2c_status = {0};
 
+/* Contadores de erro */
+static i2c_stats_t i2c_stats = {0};
+
+/* Fila de escritas: head em andamento, NULL com o barramento livre */
+static struct {
+    i2c_transaction_t * volatile head;
+    i2c_transaction_t *tail;
+    /* Timeout of a queued transaction: recovery left to task context */
+    volatile uint8_t recover;
+    /* Head waits for the stop condition of the previous one: timer polls left */
+    volatile uint8_t stop_polls;
+} i2c_queue;
+
+/* SMCLK do divisor de SCL atual: USCI reconfigurada se o clock mudar */
+static uint8_t i2c_clock_mhz;
+
 void init_i2c_master_mode()
 {
     /* Muda P1.6 e P1.7 para modo USCI_B0 */
@@ -71,14 +149,10 @@ void init_i2c_master_mode()
     /* Use SMCLK, keep SW reset */
     UCB0CTL1 = UCSSEL_2 + UCSWRST;
 
-#ifdef CLOCK_16MHz
-    /* fSCL = SMCLK/160 = ~100kHz */
-   // UCB0BR0 = 80;
-    UCB0BR0 = 160;
+    /* fSCL = SMCLK/(10 * MHz) = ~100kHz */
+    i2c_clock_mhz = clock_get_mhz();
+    UCB0BR0 = i2c_clock_mhz * I2C_SCL_DIVIDER_PER_MHZ;
     UCB0BR1 = 0;
-#else
-    #error "Clock system not defined for I2C Master Mode support"
-#endif
     /* Dummy Slave Address */
     UCB0I2CSA = 0x01;
     /* Clear SW reset, resume operation */
@@ -87,6 +161,197 @@ void init_i2c_master_mode()
 }
 
 
+/**
+  * @brief  Libera barramento travado: um escravo interrompido no meio de
+  *         um byte mantém SDA em zero. Até 9 pulsos de SCL por GPIO
+  *         terminam o byte, seguidos de uma condição de STOP.
+  *         Reinicializa a USCI ao final.
+  *
+  * @param  Nenhum
+  *
+  * @retval Nenhum.
+  */
+void i2c_bus_recovery()
+{
+    uint8_t i;
+
+    /* Hold USCI in reset and take the pins as GPIO */
+    UCB0CTL1 |= UCSWRST;
+    IE2 &= ~(UCB0TXIE + UCB0RXIE);
+    I2C_PORT_SEL &= ~(I2C_SDA + I2C_SCL);
+#ifdef I2C_PORT_SEL2
+    I2C_PORT_SEL2 &= ~(I2C_SDA + I2C_SCL);
+#endif
+
+    /* Open drain emulation: low by output, high by input and pull-up */
+    I2C_PORT_OUT &= ~(I2C_SDA + I2C_SCL);
+    I2C_PORT_DIR &= ~(I2C_SDA + I2C_SCL);
+
+    for (i=0; i < 9 && !(I2C_PORT_IN & I2C_SDA); i++) {
+        I2C_PORT_DIR |= I2C_SCL;
+        __delay_cycles(I2C_HALF_SCL_CYCLES);
+        I2C_PORT_DIR &= ~I2C_SCL;
+        __delay_cycles(I2C_HALF_SCL_CYCLES);
+    }
+
+    /* STOP: SDA rises while SCL is high */
+    I2C_PORT_DIR |= I2C_SCL;
+    I2C_PORT_DIR |= I2C_SDA;
+    __delay_cycles(I2C_HALF_SCL_CYCLES);
+    I2C_PORT_DIR &= ~I2C_SCL;
+    __delay_cycles(I2C_HALF_SCL_CYCLES);
+    I2C_PORT_DIR &= ~I2C_SDA;
+    __delay_cycles(I2C_HALF_SCL_CYCLES);
+
+    i2c_stats.recovery++;
+
+    init_i2c_master_mode();
+}
+
+/**
+  * @brief  Retorna contadores de erro do barramento.
+  *
+  * @param  Nenhum
+  *
+  * @retval Ponteiro para os contadores.
+  */
+const i2c_stats_t *i2c_get_stats()
+{
+    return &i2c_stats;
+}
+
+/* Wait for start condition sent, bounded: 0 on timeout */
+static inline uint8_t i2c_wait_start()
+{
+    uint16_t i;
+
+    for (i=0; i < I2C_STT_WAIT_LOOPS; i++)
+        if (!(UCB0CTL1 & UCTXSTT))
+            return 1;
+
+    return 0;
+}
+
+/* Timer0_A up mode, SMCLK/8: IRQ every ticks */
+static inline void i2c_timer_start(uint16_t ticks)
+{
+    I2C_TIMER_CCR0 = ticks;
+    I2C_TIMER_CCTL0 = CCIE;
+    I2C_TIMER_CTL = TASSEL_2 + ID_3 + MC_1 + TACLR;
+}
+
+static inline void i2c_timer_stop()
+{
+    I2C_TIMER_CTL = 0;
+    I2C_TIMER_CCTL0 = 0;
+}
+
+/* Program USCI for i2c_status and send start condition. The timeout
+ * timer covers this transaction */
+static void i2c_start()
+{
+    i2c_status.state = i2c_status.start_state;
+    i2c_status.rx_byte_count = i2c_status.rx_count;
+    i2c_status.tx_byte_count = i2c_status.tx_count;
+    i2c_status.rx_index = 0;
+    i2c_status.tx_index = 0;
+
+    i2c_timer_start((uint16_t)i2c_clock_mhz * I2C_TIMEOUT_TICKS_PER_MHZ);
+
+    /* Initialize slave address and interrupts */
+    UCB0I2CSA = i2c_status.slave_addr;
+    IFG2 &= ~(UCB0TXIFG + UCB0RXIFG);       // Clear any pending interrupts
+
+    if (i2c_status.start_state == RX_DATA_MODE) {
+        IE2 &= ~UCB0TXIE;                   // Disable TX interrupt
+        IE2 |= UCB0RXIE;                    // Enable RX interrupt
+
+        UCB0CTL1 &= ~UCTR;                  // I2C RX
+        UCB0CTL1 |= UCTXSTT;                // Start condition
+
+        if (i2c_status.rx_count == 1) {
+            //Must send stop since this is the N-1 byte
+            if (!i2c_wait_start())
+                i2c_status.state = TIMEOUT_MODE;
+            UCB0CTL1 |= UCTXSTP;            // Send stop condition
+        }
+    }
+    else {
+        IE2 &= ~UCB0RXIE;                   // Disable RX interrupt
+        IE2 |= UCB0TXIE;                    // Enable TX interrupt
+
+        UCB0CTL1 |= UCTR + UCTXSTT;         // I2C TX, start condition
+    }
+}
+
+/* States of a transaction in progress */
+static inline uint8_t i2c_busy()
+{
+    return i2c_status.state != IDLE_MODE && i2c_status.state != NACK_MODE &&
+            i2c_status.state != TIMEOUT_MODE;
+}
+
+/**
+  * @brief  Executa a transação descrita em i2c_status. CPU fica em LPM0
+  *         até o fim, NACK ou timeout (Timer0_A). Após NACK ou timeout
+  *         tenta novamente com espera crescente; timeout também
+  *         executa i2c_bus_recovery().
+  *
+  * @param  Nenhum
+  *
+  * @retval i2c_mode: IDLE_MODE em caso de sucesso.
+  */
+static i2c_mode i2c_transfer()
+{
+    uint8_t attempt;
+    i2c_mode state;
+
+    /* Queued writes go first */
+    i2c_flush();
+
+    /* MCLK changed since the last transfer */
+    if (i2c_clock_mhz != clock_get_mhz())
+        init_i2c_master_mode();
+
+    for (attempt=0; ; attempt++) {
+        i2c_start();
+
+        /* Enter LPM0 w/ interrupts. Test and sleep without a window
+         * for the last IRQ of the transaction. The timer is stopped
+         * before interrupts are back on: a timeout IRQ pending at the
+         * end of the transaction would otherwise still run */
+        while (1) {
+            __disable_interrupt();
+            if (!i2c_busy())
+                break;
+            __bis_SR_register(CPUOFF + GIE);
+        }
+        i2c_timer_stop();
+        __enable_interrupt();
+
+        state = i2c_status.state;
+
+        if (state == IDLE_MODE)
+            break;
+
+        if (state == NACK_MODE)
+            i2c_stats.nack++;
+        else {
+            i2c_stats.timeout++;
+            i2c_bus_recovery();
+        }
+
+        if (attempt == I2C_MAX_RETRIES) {
+            i2c_stats.failed++;
+            break;
+        }
+
+        timer_delay_ms(I2C_BACKOFF_MS << attempt);
+    }
+
+    return state;
+}
+
 /**
   * @brief  Lê registradores de um dispositivo I2C.
   *         Utiliza IRQ de transmissão para o envio dos bytes.
@@ -103,25 +368,39 @@ void init_i2c_master_mode()
 i2c_mode i2c_master_read_reg(uint8_t dev_addr, uint8_t reg_addr, uint8_t count, uint8_t *data)
 {
     /* Initialize state machine */
-    i2c_status.state = TX_REG_ADDRESS_MODE;
+    i2c_status.start_state = TX_REG_ADDRESS_MODE;
+    i2c_status.slave_addr = dev_addr;
     i2c_status.data_to_receive = data;
-
     i2c_status.device_addr = reg_addr;
-    i2c_status.rx_byte_count = count;
-    i2c_status.tx_byte_count = 0;
-    i2c_status.rx_index = 0;
-    i2c_status.tx_index = 0;
+    i2c_status.rx_count = count;
+    i2c_status.tx_count = 0;
 
-    /* Initialize slave address and interrupts */
-    UCB0I2CSA = dev_addr;
-    IFG2 &= ~(UCB0TXIFG + UCB0RXIFG);       // Clear any pending interrupts
-    IE2 &= ~UCB0RXIE;                       // Disable RX interrupt
-    IE2 |= UCB0TXIE;                        // Enable TX interrupt
+    return i2c_transfer();
+}
 
-    UCB0CTL1 |= UCTR + UCTXSTT;             // I2C TX, start condition
-    __bis_SR_register(CPUOFF + GIE);              // Enter LPM0 w/ interrupts
+/**
+  * @brief  Lê bytes de um dispositivo I2C sem enviar endereço de
+  *         registrador (sensores com comando de medição, ex. SHT3x).
+  *         Utiliza IRQ de recepção.
+  *
+  *         Use com IRS habilitadas.
+  *
+  * @param  dev_addr: endereço I2C dos dispositivo.
+  *         count: número de bytes.
+  *         data: vetor onde será armazenado os dados recebidos.
+  *
+  * @retval i2c_mode: possíveis erros de transmissão.
+  */
+i2c_mode i2c_master_read(uint8_t dev_addr, uint8_t count, uint8_t *data)
+{
+    /* Initialize state machine */
+    i2c_status.start_state = RX_DATA_MODE;
+    i2c_status.slave_addr = dev_addr;
+    i2c_status.data_to_receive = data;
+    i2c_status.rx_count = count;
+    i2c_status.tx_count = 0;
 
-    return  i2c_status.state;
+    return i2c_transfer();
 }
 
 /**
@@ -156,7 +435,8 @@ i2c_mode i2c_write_single_byte(uint8_t dev_addr, uint8_t byte){
 i2c_mode i2c_master_write_reg(uint8_t dev_addr, uint8_t reg_addr, uint8_t *reg_data, uint8_t count)
 {
     /* Initialize state machine */
-    i2c_status.state = TX_REG_ADDRESS_MODE;
+    i2c_status.start_state = TX_REG_ADDRESS_MODE;
+    i2c_status.slave_addr = dev_addr;
     i2c_status.device_addr = reg_addr;
     i2c_status.data_to_send = reg_data;
 
@@ -166,22 +446,137 @@ i2c_mode i2c_master_write_reg(uint8_t dev_addr, uint8_t reg_addr, uint8_t *reg_d
      *
     CopyArray(reg_data, TransmitBuffer, count); */
 
-    i2c_status.tx_byte_count = count;
-    i2c_status.rx_byte_count = 0;
-    i2c_status.rx_index = 0;
-    i2c_status.tx_index = 0;
+    i2c_status.tx_count = count;
+    i2c_status.rx_count = 0;
 
-    /* Initialize slave address and interrupts */
-    UCB0I2CSA = dev_addr;
-    IFG2 &= ~(UCB0TXIFG + UCB0RXIFG);       // Clear any pending interrupts
-    IE2 &= ~UCB0RXIE;                       // Disable RX interrupt
-    IE2 |= UCB0TXIE;                        // Enable TX interrupt
+    return i2c_transfer();
+}
+
+/* Load a queued transaction into i2c_status */
+static void i2c_queue_load(i2c_transaction_t *t)
+{
+    i2c_status.start_state = TX_REG_ADDRESS_MODE;
+    i2c_status.slave_addr = t->dev_addr;
+    i2c_status.device_addr = t->reg_addr;
+    i2c_status.data_to_send = t->data;
+    i2c_status.tx_count = t->count;
+    i2c_status.rx_count = 0;
+}
+
+/* IRQ: end of the queued transaction in progress. The next one starts
+ * from the timer IRQ once the stop condition is out, without a busy wait
+ * here. Returns 1 when the queue is empty: the CPU wakes up to sleep
+ * deeper */
+static uint8_t i2c_queue_next(i2c_mode state)
+{
+    i2c_transaction_t *t = i2c_queue.head;
+
+    if (state == NACK_MODE)
+        i2c_stats.nack++;
+
+    i2c_queue.head = t->next;
+    t->state = state;
+
+    if (i2c_queue.head) {
+        i2c_queue.stop_polls = I2C_STOP_POLLS;
+        i2c_timer_start((uint16_t)i2c_clock_mhz * I2C_STOP_TICKS_PER_MHZ);
+        return 0;
+    }
+
+    i2c_timer_stop();
+
+    return 1;
+}
+
+/**
+  * @brief  Enfileira uma escrita em registradores. Não bloqueia: a
+  *         transação começa agora se o barramento estiver livre, ou pela
+  *         IRQ ao fim da anterior. Sem novas tentativas: o resultado fica
+  *         em t->state (i2c_queue_done()).
+  *
+  *         Use com ISR habilitadas.
+  *
+  * @param  t: transação. dev_addr, reg_addr, data e count preenchidos;
+  *            a estrutura e os dados devem permanecer estáticos até o fim.
+  *
+  * @retval Nenhum.
+  */
+void i2c_queue_write(i2c_transaction_t *t)
+{
+    t->next = NULL;
+    t->state = TX_REG_ADDRESS_MODE;
+
+    __disable_interrupt();
+    if (i2c_queue.head) {
+        i2c_queue.tail->next = t;
+        i2c_queue.tail = t;
+        __enable_interrupt();
+        return;
+    }
+    __enable_interrupt();
 
-    UCB0CTL1 |= UCTR + UCTXSTT;             // I2C TX, start condition
+    /* Bus idle: the IRQ does not touch the queue until it is started */
+    if (i2c_queue.recover) {
+        i2c_queue.recover = 0;
+        i2c_bus_recovery();
+    }
+    if (i2c_clock_mhz != clock_get_mhz())
+        init_i2c_master_mode();
 
-    __bis_SR_register(CPUOFF + GIE);        // Enter LPM0 w/ interrupts: Use no hardware real
+    i2c_queue.head = t;
+    i2c_queue.tail = t;
+    i2c_queue_load(t);
+    i2c_start();
+}
 
-    return i2c_status.state;
+/**
+  * @brief  Informa se uma transação enfileirada terminou.
+  *
+  * @param  t: transação passada a i2c_queue_write().
+  *
+  * @retval 1 se terminou: t->state é IDLE_MODE em caso de sucesso.
+  */
+uint8_t i2c_queue_done(const i2c_transaction_t *t)
+{
+    return t->state != TX_REG_ADDRESS_MODE;
+}
+
+/**
+  * @brief  Informa se há escritas enfileiradas: SMCLK deve permanecer
+  *         ligado (no máximo LPM0).
+  *
+  * @param  Nenhum
+  *
+  * @retval 1 se ocupado.
+  */
+uint8_t i2c_queue_busy()
+{
+    return i2c_queue.head != NULL;
+}
+
+/**
+  * @brief  Espera em LPM0 o fim das escritas enfileiradas. Executa
+  *         i2c_bus_recovery() se alguma terminou por timeout.
+  *
+  * @param  Nenhum
+  *
+  * @retval Nenhum.
+  */
+void i2c_flush()
+{
+    /* Test and sleep without a window for the last IRQ */
+    while (1) {
+        __disable_interrupt();
+        if (!i2c_queue.head)
+            break;
+        __bis_SR_register(CPUOFF + GIE);
+    }
+    __enable_interrupt();
+
+    if (i2c_queue.recover) {
+        i2c_queue.recover = 0;
+        i2c_bus_recovery();
+    }
 }
 
 
@@ -199,15 +594,18 @@ void CopyArray(uint8_t *source, uint8_t *dest, uint8_t count)
 // I2C Interrupt For Received and Transmitted Data******************************
 //******************************************************************************
 
-#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
-#pragma vector = USCIAB0TX_VECTOR
-__interrupt void USCIAB0TX_ISR(void)
-#elif defined(__GNUC__)
-void __attribute__ ((interrupt(USCIAB0TX_VECTOR))) USCIAB0TX_ISR (void)
-#else
-#error Compiler not supported!
-#endif
+/**
+  * @brief  Tratamento da IRQ de dados do USCI_B0. Chamada pela ISR
+  *         USCIAB0TX (usci_ab0_isr.c), compartilhada com USCI_A0.
+  *
+  * @param  Nenhum
+  *
+  * @retval 1 para acordar a CPU.
+  */
+uint8_t i2c_master_data_isr()
 {
+  uint8_t wake = 0;
+
   if (IFG2 & UCB0RXIFG)                 // Receive Data Interrupt
   {
       //Must read from UCB0RXBUF
@@ -225,7 +623,7 @@ void __attribute__ ((interrupt(USCIAB0TX_VECTOR))) USCIAB0TX_ISR (void)
       else if (i2c_status.rx_byte_count == 0) {
           IE2 &= ~UCB0RXIE;
           i2c_status.state = IDLE_MODE;
-          __bic_SR_register_on_exit(CPUOFF);      // Exit LPM0
+          wake = 1;      // Exit LPM0
       }
   }
   else if (IFG2 & UCB0TXIFG)            // Transmit Data Interrupt
@@ -248,7 +646,10 @@ void __attribute__ ((interrupt(USCIAB0TX_VECTOR))) USCIAB0TX_ISR (void)
               UCB0CTL1 |= UCTXSTT;          // Send repeated start
               if (i2c_status.rx_byte_count == 1) {
                   //Must send stop since this is the N-1 byte
-                  while((UCB0CTL1 & UCTXSTT));
+                  if (!i2c_wait_start()) {
+                      i2c_status.state = TIMEOUT_MODE;
+                      wake = 1;
+                  }
                   UCB0CTL1 |= UCTXSTP;      // Send stop condition
               }
               break;
@@ -263,7 +664,10 @@ void __attribute__ ((interrupt(USCIAB0TX_VECTOR))) USCIAB0TX_ISR (void)
                   UCB0CTL1 |= UCTXSTP;     // Send stop condition
                   i2c_status.state = IDLE_MODE;
                   IE2 &= ~UCB0TXIE;                       // disable TX interrupt
-                  __bic_SR_register_on_exit(CPUOFF);      // Exit LPM0
+                  if (i2c_queue.head)
+                      wake = i2c_queue_next(IDLE_MODE);
+                  else
+                      wake = 1;      // Exit LPM0
               }
               break;
 
@@ -272,6 +676,8 @@ void __attribute__ ((interrupt(USCIAB0TX_VECTOR))) USCIAB0TX_ISR (void)
               break;
       }
   }
+
+  return wake;
 }
 
 
@@ -279,21 +685,30 @@ void __attribute__ ((interrupt(USCIAB0TX_VECTOR))) USCIAB0TX_ISR (void)
 // I2C Interrupt For Start, Restart, Nack, Stop ********************************
 //******************************************************************************
 
-#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
-#pragma vector = USCIAB0RX_VECTOR
-__interrupt void USCIAB0RX_ISR(void)
-#elif defined(__GNUC__)
-void __attribute__ ((interrupt(USCIAB0RX_VECTOR))) USCIAB0RX_ISR (void)
-#else
-#error Compiler not supported!
-#endif
+/**
+  * @brief  Tratamento da IRQ de estado do USCI_B0. Chamada pela ISR
+  *         USCIAB0RX (usci_ab0_isr.c), compartilhada com USCI_A0.
+  *
+  * @param  Nenhum
+  *
+  * @retval 1 para acordar a CPU.
+  */
+uint8_t i2c_master_state_isr()
 {
+    uint8_t wake = 0;
+
     if (UCB0STAT & UCNACKIFG)
     {
-        /* Limpa NACK flags, sinaliza NACK e acorda CPU */
+        /* Libera barramento com STOP, limpa NACK flags,
+         * sinaliza NACK e acorda CPU */
+        UCB0CTL1 |= UCTXSTP;
+        IE2 &= ~(UCB0TXIE + UCB0RXIE);
         i2c_status.state = NACK_MODE;
         UCB0STAT &= ~UCNACKIFG;
-        __bic_SR_register_on_exit(CPUOFF);
+        if (i2c_queue.head)
+            wake = i2c_queue_next(NACK_MODE);
+        else
+            wake = 1;
     }
     /* Stop or NACK Interrupt */
     if (UCB0STAT & UCSTPIFG)
@@ -306,4 +721,55 @@ void __attribute__ ((interrupt(USCIAB0RX_VECTOR))) USCIAB0RX_ISR (void)
         /* Limpa START Flags */
         UCB0STAT &= ~(UCSTTIFG);
     }
+
+    return wake;
+}
+
+
+//******************************************************************************
+// Timer Interrupt For Transaction Timeout *************************************
+//******************************************************************************
+
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector = I2C_TIMER_VECTOR
+__interrupt void I2C_TIMEOUT_ISR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(I2C_TIMER_VECTOR))) I2C_TIMEOUT_ISR (void)
+#else
+#error Compiler not supported!
+#endif
+{
+    i2c_transaction_t *t;
+
+    /* Queue between two transactions: start the next one once the stop
+     * condition is out. The timer keeps running for the next poll */
+    if (i2c_queue.stop_polls) {
+        if (!(UCB0CTL1 & UCTXSTP)) {
+            i2c_queue.stop_polls = 0;
+            i2c_queue_load(i2c_queue.head);
+            i2c_start();
+            return;
+        }
+        if (--i2c_queue.stop_polls)
+            return;
+        /* Stop never sent: the bus is stuck as after a timeout */
+    }
+
+    /* Stop timer, abort transaction and wake up CPU */
+    i2c_timer_stop();
+    IE2 &= ~(UCB0TXIE + UCB0RXIE);
+    i2c_status.state = TIMEOUT_MODE;
+
+    /* Queued: the bus is stuck, the rest of the queue fails too */
+    if (i2c_queue.head) {
+        i2c_stats.timeout++;
+        i2c_queue.recover = 1;
+        while (i2c_queue.head) {
+            t = i2c_queue.head;
+            i2c_queue.head = t->next;
+            t->state = TIMEOUT_MODE;
+        }
+    }
+
+    __bic_SR_register_on_exit(CPUOFF);
 }
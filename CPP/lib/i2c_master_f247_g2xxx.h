@@ -11,7 +11,7 @@
 
 #include <stdint.h>
 
-#define CLOCK_16MHz
+#include <lib/clock.h>
 
 typedef enum i2c_modeE_enum{
     IDLE_MODE,
@@ -25,6 +25,28 @@ typedef enum i2c_modeE_enum{
     TIMEOUT_MODE
 } i2c_mode;
 
+/* Bus error counters */
+typedef struct {
+    uint16_t nack;          /* NACK received */
+    uint16_t timeout;       /* transaction did not finish in time */
+    uint16_t recovery;      /* bus recovery executed */
+    uint16_t failed;        /* transaction given up after all retries */
+} i2c_stats_t;
+
+/* Queued write (i2c_queue_write()): register address and data sent in
+ * the background, after the transactions queued before it. Owned by the
+ * queue until i2c_queue_done(): data must stay unchanged meanwhile */
+typedef struct i2c_transaction {
+    uint8_t dev_addr;
+    uint8_t reg_addr;
+    uint8_t *data;
+    uint8_t count;
+    /* TX_REG_ADDRESS_MODE while queued, then IDLE_MODE, NACK_MODE or
+     * TIMEOUT_MODE: no retries */
+    volatile i2c_mode state;
+    struct i2c_transaction *next;
+} i2c_transaction_t;
+
 #ifdef __cplusplus
     #define EXPORT_C extern "C"
 #else
@@ -35,6 +57,16 @@ EXPORT_C void init_i2c_master_mode();
 EXPORT_C i2c_mode i2c_write_single_byte(uint8_t dev_addr, uint8_t byte);
 EXPORT_C i2c_mode i2c_master_write_reg(uint8_t dev_addr, uint8_t reg_addr, uint8_t *reg_data, uint8_t count);
 EXPORT_C i2c_mode i2c_master_read_reg(uint8_t dev_addr, uint8_t reg_addr, uint8_t count, uint8_t *data);
+EXPORT_C i2c_mode i2c_master_read(uint8_t dev_addr, uint8_t count, uint8_t *data);
+EXPORT_C void i2c_queue_write(i2c_transaction_t *t);
+EXPORT_C uint8_t i2c_queue_done(const i2c_transaction_t *t);
+EXPORT_C uint8_t i2c_queue_busy();
+EXPORT_C void i2c_flush();
+EXPORT_C void i2c_bus_recovery();
+EXPORT_C const i2c_stats_t *i2c_get_stats();
+/* USCI_B0 IRQ handlers: called by the shared USCIAB0 ISRs, return 1 to wake up CPU */
+EXPORT_C uint8_t i2c_master_data_isr();
+EXPORT_C uint8_t i2c_master_state_isr();
 EXPORT_C void CopyArray(uint8_t *source, uint8_t *dest, uint8_t count);
 
 #endif /* LIB_I2C_MASTER_F2247_G2xxx_H_ */
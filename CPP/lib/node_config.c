@@ -0,0 +1,30 @@
+/*
+ *  node_config.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      - Leitura da configuração do nó na flash de informação (INFOD).
+ */
+
+/* System includes */
+#include <lib/node_config.h>
+#include <stdint.h>
+
+/* Information memory segment D: same address on G2553 and F247 */
+#define NODE_CONFIG     ((const node_config_t *)0x1000)
+
+/**
+  * @brief  Endereço do nó gravado na flash de informação.
+  *
+  * @param  default_address: endereço se o segmento estiver apagado.
+  *
+  * @retval Endereço do nó.
+  */
+uint16_t node_config_address(uint16_t default_address)
+{
+    if (NODE_CONFIG->magic != NODE_CONFIG_MAGIC)
+        return default_address;
+
+    return NODE_CONFIG->address;
+}
@@ -0,0 +1,39 @@
+/*
+ * node_config.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Per unit configuration kept in information memory segment D
+ *      (0x1000), so every board runs the same firmware image. The segment
+ *      is written once by the programmer, e.g. an Intel HEX file with
+ *
+ *          0x1000: 43 4E   magic "CN"
+ *          0x1002: LL HH   node address, little endian
+ *
+ *      An erased segment (0xFF) keeps the address built in the firmware.
+ */
+
+#ifndef LIB_NODE_CONFIG_H_
+#define LIB_NODE_CONFIG_H_
+
+#include <stdint.h>
+
+#define NODE_CONFIG_MAGIC       0x4E43
+
+typedef struct {
+    uint16_t magic;
+    uint16_t address;
+} node_config_t;
+
+#ifndef EXPORT_C
+#ifdef __cplusplus
+    #define EXPORT_C extern "C"
+#else
+    #define EXPORT_C
+#endif
+#endif
+
+EXPORT_C uint16_t node_config_address(uint16_t default_address);
+
+#endif /* LIB_NODE_CONFIG_H_ */
@@ -0,0 +1,97 @@
+/*
+ * pin.h : Compile-time GPIO pin descriptors
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Port classes map a port to its registers and Pin<PORT, MASK>
+ *      binds a pin (or a group of pins of the same port) at compile time.
+ *      Every method is a static inline access to a fixed register, so
+ *      Pin<Port1, BIT0>::set() compiles to a single BIS.B instruction.
+ *
+ *      Drivers take the pin as a template parameter:
+ *
+ *          typedef Pin<Port2, BIT0> DhtPin;
+ *          Dht22<DhtPin> sensor;
+ *
+ *      On host builds the registers come from the mock msp430.h.
+ */
+
+#ifndef LIB_PIN_H_
+#define LIB_PIN_H_
+
+#include <msp430.h>
+#include <stdint.h>
+
+struct Port1 {
+    static inline volatile uint8_t &in()  { return P1IN; }
+    static inline volatile uint8_t &out() { return P1OUT; }
+    static inline volatile uint8_t &dir() { return P1DIR; }
+    static inline volatile uint8_t &ren() { return P1REN; }
+    static inline volatile uint8_t &sel() { return P1SEL; }
+    static inline volatile uint8_t &ie()  { return P1IE; }
+    static inline volatile uint8_t &ies() { return P1IES; }
+    static inline volatile uint8_t &ifg() { return P1IFG; }
+};
+
+struct Port2 {
+    static inline volatile uint8_t &in()  { return P2IN; }
+    static inline volatile uint8_t &out() { return P2OUT; }
+    static inline volatile uint8_t &dir() { return P2DIR; }
+    static inline volatile uint8_t &ren() { return P2REN; }
+    static inline volatile uint8_t &sel() { return P2SEL; }
+    static inline volatile uint8_t &ie()  { return P2IE; }
+    static inline volatile uint8_t &ies() { return P2IES; }
+    static inline volatile uint8_t &ifg() { return P2IFG; }
+};
+
+template <class PORT, uint8_t MASK>
+struct Pin {
+    typedef PORT port;
+    static const uint8_t mask = MASK;
+
+    /* Pin direction */
+    static inline void output() { PORT::dir() |= MASK; }
+    static inline void input()  { PORT::dir() &= ~MASK; }
+
+    /* Output level */
+    static inline void set()    { PORT::out() |= MASK; }
+    static inline void clear()  { PORT::out() &= ~MASK; }
+    static inline void toggle() { PORT::out() ^= MASK; }
+
+    /* Input level: non zero if any pin of MASK is high */
+    static inline uint8_t read() { return PORT::in() & MASK; }
+
+    /* Input with pull-up resistor */
+    static inline void pull_up() {
+        PORT::ren() |= MASK;
+        PORT::out() |= MASK;
+    }
+
+    /* Digital I/O function */
+    static inline void gpio() { PORT::sel() &= ~MASK; }
+};
+
+/* Optional pin of a driver left unconnected: every access is a no-op */
+struct NoPin {
+    static const uint8_t mask = 0;
+
+    static inline void output() {}
+    static inline void input()  {}
+    static inline void set()    {}
+    static inline void clear()  {}
+    static inline void toggle() {}
+    static inline uint8_t read() { return 0; }
+    static inline void pull_up() {}
+    static inline void gpio()   {}
+};
+
+/* ADC10 analog input Ax: channel select and analog enable bit.
+ * Channels above 7 are internal (INCH_10: temperature sensor). */
+template <uint8_t CHANNEL>
+struct AnalogPin {
+    static const uint16_t inch = (uint16_t)CHANNEL << 12;
+    static const uint8_t ae_mask = CHANNEL < 8 ? (uint8_t)(1 << CHANNEL) : 0;
+};
+
+#endif /* LIB_PIN_H_ */
@@ -0,0 +1,158 @@
+/*
+ *  rs485.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      - Enlace RS-485 half-duplex no USCI_A0 (uart.c para TX).
+ *      - Quadros recebidos byte a byte pela IRQ de RX: a CPU só acorda
+ *        para um POLL com o endereço do nó.
+ *      - Em LPM3 o SMCLK está desligado: o USCI o religa sozinho na
+ *        borda de start do RX (ativação automática de clock), o DCO
+ *        parte em menos de 1us e o byte é recebido normalmente.
+ *      - DE/RE# do transceptor: nível alto transmite.
+ *
+ *                MSP430G2553                  MAX3485
+ *             -----------------            -----------
+ *            |     P1.2/UCA0TXD|---------->|DI        |
+ *            |     P1.1/UCA0RXD|<----------|RO     A/B|<===> bus
+ *            |             P1.5|------+--->|DE        |
+ *            |                 |      +--->|RE#       |
+ *
+ *                MSP430F247
+ *             -----------------
+ *            |     P3.4/UCA0TXD|----> DI
+ *            |     P3.5/UCA0RXD|<---- RO
+ *            |             P3.6|----> DE, RE#
+ */
+
+/* System includes */
+#include <lib/rs485.h>
+#include <lib/telemetry_frame.h>
+#include <msp430.h>
+#include <stdint.h>
+
+#if defined(__MSP430G2553__)
+    #define RS485_DE_OUT    P1OUT
+    #define RS485_DE_DIR    P1DIR
+    #define RS485_DE_BIT    BIT5
+#elif defined(__MSP430F247__)
+    #define RS485_DE_OUT    P3OUT
+    #define RS485_DE_DIR    P3DIR
+    #define RS485_DE_BIT    BIT6
+#else
+    #error "Library no supported/validated in this device."
+#endif
+
+static telemetry_rx_t rx;
+static volatile uint8_t rx_ready;
+static uint16_t my_address;
+
+/**
+  * @brief  Configura RX, pino DE e endereço do nó. Chamar depois de
+  *         init_uart().
+  *
+  * @param  address: endereço do nó no barramento.
+  *
+  * @retval Nenhum.
+  */
+void init_rs485(uint16_t address)
+{
+    my_address = address;
+    rx.count = 0;
+    rx_ready = 0;
+
+    /* Receiver enabled: DE/RE# low */
+    RS485_DE_OUT &= ~RS485_DE_BIT;
+    RS485_DE_DIR |= RS485_DE_BIT;
+
+    /* RX pin as USCI_A0 */
+#if defined(__MSP430F247__)
+    P3SEL |= BIT5;
+#endif
+
+#if defined(__MSP430G2553__)
+    P1SEL |= BIT1;
+    P1SEL2 |= BIT1;
+#endif
+
+    IE2 |= UCA0RXIE;
+}
+
+/**
+  * @brief  Quadro de requisição pendente.
+  *
+  * @param  Nenhum
+  *
+  * @retval Quadro completo (cabeçalho em [0]) ou 0.
+  */
+const uint8_t *rs485_request()
+{
+    return rx_ready ? rx.buf : 0;
+}
+
+/**
+  * @brief  Libera o buffer de recepção para o próximo quadro.
+  *
+  * @param  Nenhum
+  *
+  * @retval Nenhum.
+  */
+void rs485_release()
+{
+    rx.count = 0;
+    rx_ready = 0;
+}
+
+/**
+  * @brief  Transmite um quadro: habilita o driver, espera o último stop
+  *         bit em LPM0 e volta a receber.
+  *
+  * @param  frame: quadro.
+  *         size: tamanho, até UART_TX_BUFFER_SIZE - 1.
+  *
+  * @retval Nenhum.
+  */
+void rs485_send(const uint8_t *frame, uint8_t size)
+{
+    RS485_DE_OUT |= RS485_DE_BIT;
+
+    uart_write(frame, size);
+    uart_flush();
+
+    RS485_DE_OUT &= ~RS485_DE_BIT;
+}
+
+/**
+  * @brief  Tratamento da IRQ de RX do USCI_A0. Chamada pela ISR
+  *         USCIAB0RX (usci_ab0_isr.c).
+  *
+  * @param  Nenhum
+  *
+  * @retval 1 para acordar a CPU: POLL para este nó.
+  */
+uint8_t rs485_rx_isr()
+{
+    uint8_t byte = UCA0RXBUF;
+    uint16_t node;
+
+    /* Previous request not handled yet */
+    if (rx_ready)
+        return 0;
+
+    if (!telemetry_rx_byte(&rx, byte))
+        return 0;
+
+    if (rx.buf[3] != TELEMETRY_TYPE_POLL || rx.buf[2] != TELEMETRY_POLL_SIZE)
+        return 0;
+
+    node = rx.buf[TELEMETRY_HEADER_SIZE + TELEMETRY_POLL_NODE] |
+           rx.buf[TELEMETRY_HEADER_SIZE + TELEMETRY_POLL_NODE + 1] << 8;
+
+    if (node != my_address)
+        return 0;
+
+    rx_ready = 1;
+
+    return 1;
+}
@@ -0,0 +1,40 @@
+/*
+ * rs485.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Half-duplex RS-485 link on USCI_A0 for the polled telemetry bus
+ *      (lib/telemetry_frame.h). Frames are assembled by the RX IRQ, which
+ *      only wakes the CPU for a POLL addressed to this node: the node
+ *      can stay in LPM3 while the collector talks to the others.
+ */
+
+#ifndef LIB_RS485_H_
+#define LIB_RS485_H_
+
+#include <stdint.h>
+
+#include <lib/uart.h>
+
+#ifndef EXPORT_C
+#ifdef __cplusplus
+    #define EXPORT_C extern "C"
+#else
+    #define EXPORT_C
+#endif
+#endif
+
+EXPORT_C void init_rs485(uint16_t address);
+
+/* Pending request frame (header included) or 0 */
+EXPORT_C const uint8_t *rs485_request();
+EXPORT_C void rs485_release();
+
+/* Drive the bus, send and release it after the last stop bit */
+EXPORT_C void rs485_send(const uint8_t *frame, uint8_t size);
+
+/* USCI_A0 RX IRQ handler: called by the shared USCIAB0RX ISR */
+EXPORT_C uint8_t rs485_rx_isr();
+
+#endif /* LIB_RS485_H_ */
@@ -0,0 +1,123 @@
+/*
+ *  telemetry_frame.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      - Montagem do quadro binário de telemetria (telemetry_frame.h).
+ */
+
+#include <lib/telemetry_frame.h>
+#include <lib/crc.h>
+
+static inline void put_u16(uint8_t *p, uint16_t value)
+{
+    p[0] = value;
+    p[1] = value >> 8;
+}
+
+/**
+  * @brief  Escreve o payload de uma amostra (TELEMETRY_SAMPLE_SIZE bytes).
+  *
+  * @param  sample: amostra.
+  *         payload: destino.
+  *
+  * @retval Nenhum.
+  */
+void telemetry_encode_sample(const telemetry_sample_t *sample, uint8_t *payload)
+{
+    put_u16(payload + TELEMETRY_NODE, sample->node);
+    put_u16(payload + TELEMETRY_SEQ, sample->seq);
+    put_u16(payload + TELEMETRY_TIMESTAMP, sample->timestamp);
+    put_u16(payload + TELEMETRY_TIMESTAMP + 2, sample->timestamp >> 16);
+    put_u16(payload + TELEMETRY_TEMPERATURE, sample->temperature);
+    put_u16(payload + TELEMETRY_HUMIDITY, sample->humidity);
+    put_u16(payload + TELEMETRY_BATTERY, sample->battery_mv);
+    put_u16(payload + TELEMETRY_I2C_ERRORS, sample->i2c_errors);
+    put_u16(payload + TELEMETRY_SENSOR_ERRORS, sample->sensor_errors);
+    payload[TELEMETRY_STATUS] = sample->status;
+}
+
+/**
+  * @brief  Completa o quadro: sincronismo, tamanho, tipo e CRC. O
+  *         payload já deve estar em frame + TELEMETRY_HEADER_SIZE.
+  *
+  * @param  frame: quadro.
+  *         type: TELEMETRY_TYPE_x.
+  *         size: tamanho do payload.
+  *
+  * @retval Tamanho do quadro.
+  */
+uint8_t telemetry_close(uint8_t *frame, uint8_t type, uint8_t size)
+{
+    frame[0] = TELEMETRY_SYNC0;
+    frame[1] = TELEMETRY_SYNC1;
+    frame[2] = size;
+    frame[3] = type;
+
+    put_u16(frame + TELEMETRY_HEADER_SIZE + size, crc16_ccitt(frame + 2, size + 2));
+
+    return TELEMETRY_HEADER_SIZE + size + TELEMETRY_CRC_SIZE;
+}
+
+/**
+  * @brief  Monta quadro de amostra.
+  *
+  * @param  sample: amostra.
+  *         frame: destino, TELEMETRY_FRAME_MAX bytes.
+  *
+  * @retval Tamanho do quadro.
+  */
+uint8_t telemetry_encode(const telemetry_sample_t *sample, uint8_t *frame)
+{
+    telemetry_encode_sample(sample, frame + TELEMETRY_HEADER_SIZE);
+
+    return telemetry_close(frame, TELEMETRY_TYPE_SAMPLE, TELEMETRY_SAMPLE_SIZE);
+}
+
+/**
+  * @brief  Recepção byte a byte (ISR). Procura o sincronismo, descarta
+  *         quadros maiores que TELEMETRY_RX_PAYLOAD_MAX e confere o CRC.
+  *
+  * @param  rx: estado do receptor.
+  *         byte: byte recebido.
+  *
+  * @retval 1 quando rx->buf contém um quadro válido.
+  */
+uint8_t telemetry_rx_byte(telemetry_rx_t *rx, uint8_t byte)
+{
+    uint8_t size;
+    uint16_t crc;
+
+    switch (rx->count) {
+    case 0:
+        if (byte != TELEMETRY_SYNC0)
+            return 0;
+        break;
+    case 1:
+        if (byte != TELEMETRY_SYNC1) {
+            rx->count = (byte == TELEMETRY_SYNC0);
+            return 0;
+        }
+        break;
+    case 2:
+        if (byte > TELEMETRY_RX_PAYLOAD_MAX) {
+            rx->count = 0;
+            return 0;
+        }
+        break;
+    }
+
+    rx->buf[rx->count++] = byte;
+    if (rx->count < 3)
+        return 0;
+
+    size = TELEMETRY_HEADER_SIZE + rx->buf[2] + TELEMETRY_CRC_SIZE;
+    if (rx->count < size)
+        return 0;
+
+    rx->count = 0;
+    crc = rx->buf[size - 2] | rx->buf[size - 1] << 8;
+
+    return crc16_ccitt(rx->buf + 2, size - 4) == crc;
+}
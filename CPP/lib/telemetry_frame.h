@@ -0,0 +1,105 @@
+/*
+ * telemetry_frame.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Binary telemetry frame, shared by firmware and host tools.
+ *
+ *      +-------+-------+-----+------+-------------+-----------+
+ *      | SYNC0 | SYNC1 | LEN | TYPE | payload[LEN]| CRC16 (LE)|
+ *      +-------+-------+-----+------+-------------+-----------+
+ *
+ *      CRC16 CCITT covers LEN, TYPE and payload. Multi-byte fields are
+ *      little endian, at the offsets below.
+ *
+ *      Streaming nodes send one SAMPLE frame per measurement. On a polled
+ *      RS-485 bus the collector sends POLL to one node, which answers with
+ *      a BATCH of the samples newer than the sequence number given.
+ */
+
+#ifndef LIB_TELEMETRY_FRAME_H_
+#define LIB_TELEMETRY_FRAME_H_
+
+#include <stdint.h>
+
+#define TELEMETRY_SYNC0             0xA5
+#define TELEMETRY_SYNC1             0x5A
+
+#define TELEMETRY_HEADER_SIZE       4
+#define TELEMETRY_CRC_SIZE          2
+
+/* Frame types */
+#define TELEMETRY_TYPE_SAMPLE       0x01
+#define TELEMETRY_TYPE_POLL         0x10
+#define TELEMETRY_TYPE_BATCH        0x11
+
+/* Sample payload offsets */
+#define TELEMETRY_NODE              0   /* uint16_t: node address */
+#define TELEMETRY_SEQ               2   /* uint16_t: sample sequence */
+#define TELEMETRY_TIMESTAMP         4   /* uint32_t: node uptime in WDT ticks */
+#define TELEMETRY_TEMPERATURE       8   /* int16_t: tenths of oC */
+#define TELEMETRY_HUMIDITY          10  /* uint16_t: tenths of %RH */
+#define TELEMETRY_BATTERY           12  /* uint16_t: mV */
+#define TELEMETRY_I2C_ERRORS        14  /* uint16_t: I2C NACK + timeouts */
+#define TELEMETRY_SENSOR_ERRORS     16  /* uint16_t: failed sensor reads */
+#define TELEMETRY_STATUS            18  /* uint8_t: TELEMETRY_STATUS_x bits */
+#define TELEMETRY_SAMPLE_SIZE       19
+
+#define TELEMETRY_FRAME_MAX         (TELEMETRY_HEADER_SIZE + TELEMETRY_SAMPLE_SIZE + TELEMETRY_CRC_SIZE)
+
+/* Poll payload: collector -> node */
+#define TELEMETRY_POLL_NODE         0   /* uint16_t: destination node */
+#define TELEMETRY_POLL_SINCE        2   /* uint16_t: last sequence received */
+#define TELEMETRY_POLL_MAX          4   /* uint8_t: samples wanted */
+#define TELEMETRY_POLL_SIZE         5
+
+/* Batch payload: node -> collector, followed by COUNT sample payloads */
+#define TELEMETRY_BATCH_NODE        0   /* uint16_t: source node */
+#define TELEMETRY_BATCH_COUNT       2   /* uint8_t: number of samples */
+#define TELEMETRY_BATCH_SAMPLES     3
+#define TELEMETRY_BATCH_MAX         2
+#define TELEMETRY_BATCH_FRAME_MAX   (TELEMETRY_HEADER_SIZE + TELEMETRY_BATCH_SAMPLES + \
+                                     TELEMETRY_BATCH_MAX * TELEMETRY_SAMPLE_SIZE + TELEMETRY_CRC_SIZE)
+
+/* Status bits */
+#define TELEMETRY_STATUS_VALID      0x01    /* temperature/humidity are valid */
+/* Cause of an invalid reading: DHT22_x result of Dht22.h */
+#define TELEMETRY_STATUS_CAUSE_MASK 0x0E
+#define TELEMETRY_STATUS_CAUSE(s)   (((s) & TELEMETRY_STATUS_CAUSE_MASK) >> 1)
+#define TELEMETRY_STATUS_CAUSES     8
+
+typedef struct {
+    uint16_t node;
+    uint16_t seq;
+    uint32_t timestamp;
+    int16_t temperature;
+    uint16_t humidity;
+    uint16_t battery_mv;
+    uint16_t i2c_errors;
+    uint16_t sensor_errors;
+    uint8_t status;
+} telemetry_sample_t;
+
+#ifndef EXPORT_C
+#ifdef __cplusplus
+    #define EXPORT_C extern "C"
+#else
+    #define EXPORT_C
+#endif
+#endif
+
+/* Frame receiver: longer frames are skipped */
+#define TELEMETRY_RX_PAYLOAD_MAX    8
+
+typedef struct {
+    uint8_t buf[TELEMETRY_HEADER_SIZE + TELEMETRY_RX_PAYLOAD_MAX + TELEMETRY_CRC_SIZE];
+    uint8_t count;
+} telemetry_rx_t;
+
+EXPORT_C uint8_t telemetry_encode(const telemetry_sample_t *sample, uint8_t *frame);
+EXPORT_C void telemetry_encode_sample(const telemetry_sample_t *sample, uint8_t *payload);
+EXPORT_C uint8_t telemetry_close(uint8_t *frame, uint8_t type, uint8_t size);
+EXPORT_C uint8_t telemetry_rx_byte(telemetry_rx_t *rx, uint8_t byte);
+
+#endif /* LIB_TELEMETRY_FRAME_H_ */
@@ -0,0 +1,94 @@
+/*
+ *  timer_delay.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      - Atrasos em milissegundos com a CPU em LPM0.
+ *      - Timer em modo contínuo, SMCLK/8. A comparação do CCR0 acorda
+ *        a ISR a cada 1ms; a CPU só volta ao main no final do atraso.
+ *      - Período calculado a cada chamada com clock_get_mhz().
+ */
+
+/* System includes */
+#include <lib/timer_delay.h>
+#include <msp430.h>
+#include <stdint.h>
+
+#if defined(__MSP430G2553__)
+    #define DELAY_CTL       TA1CTL
+    #define DELAY_R         TA1R
+    #define DELAY_CCTL0     TA1CCTL0
+    #define DELAY_CCR0      TA1CCR0
+    #define DELAY_CTL_CFG   (TASSEL_2 + ID_3 + MC_2 + TACLR)
+    #define DELAY_VECTOR    TIMER1_A0_VECTOR
+#elif defined(__MSP430F247__)
+    #define DELAY_CTL       TBCTL
+    #define DELAY_R         TBR
+    #define DELAY_CCTL0     TBCCTL0
+    #define DELAY_CCR0      TBCCR0
+    #define DELAY_CTL_CFG   (TBSSEL_2 + ID_3 + MC_2 + TBCLR)
+    #define DELAY_VECTOR    TIMERB0_VECTOR
+#else
+    #error "Library no supported/validated in this device."
+#endif
+
+/* SMCLK/8 ticks in 1ms per MHz of SMCLK: 2000 at 16MHz */
+#define DELAY_TICKS_PER_MHZ 125
+
+static volatile uint16_t delay_ms_left;
+static uint16_t delay_ticks;
+
+/**
+  * @brief  Atraso em milissegundos com a CPU em LPM0.
+  *         Outras IRQs podem acordar a CPU: ela volta a dormir
+  *         até o fim do atraso.
+  *
+  *         Use com IRS habilitadas.
+  *
+  * @param  ms: tempo em milissegundos.
+  *
+  * @retval Nenhum.
+  */
+void timer_delay_ms(uint16_t ms)
+{
+    if (!ms)
+        return;
+
+    delay_ms_left = ms;
+    delay_ticks = clock_get_mhz() * DELAY_TICKS_PER_MHZ;
+
+    DELAY_CTL = DELAY_CTL_CFG;
+    DELAY_CCR0 = delay_ticks;
+    DELAY_CCTL0 = CCIE;
+
+    /* Test and sleep without a window for the last IRQ */
+    while (1) {
+        __disable_interrupt();
+        if (!delay_ms_left)
+            break;
+        __bis_SR_register(LPM0_bits + GIE);
+    }
+    __enable_interrupt();
+
+    /* Stop timer */
+    DELAY_CTL = 0;
+}
+
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector = DELAY_VECTOR
+__interrupt void DELAY_ISR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(DELAY_VECTOR))) DELAY_ISR (void)
+#else
+#error Compiler not supported!
+#endif
+{
+    if (--delay_ms_left) {
+        DELAY_CCR0 += delay_ticks;
+    }
+    else {
+        DELAY_CCTL0 = 0;
+        __bic_SR_register_on_exit(LPM0_bits);
+    }
+}
@@ -0,0 +1,28 @@
+/*
+ * timer_delay.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Millisecond delays with the CPU in LPM0.
+ *      Uses Timer1_A3 (G2553) or Timer_B (F247): Timer0_A is left free.
+ */
+
+#ifndef LIB_TIMER_DELAY_H_
+#define LIB_TIMER_DELAY_H_
+
+#include <stdint.h>
+
+#include <lib/clock.h>
+
+#ifndef EXPORT_C
+#ifdef __cplusplus
+    #define EXPORT_C extern "C"
+#else
+    #define EXPORT_C
+#endif
+#endif
+
+EXPORT_C void timer_delay_ms(uint16_t ms);
+
+#endif /* LIB_TIMER_DELAY_H_ */
@@ -0,0 +1,209 @@
+/*
+ *  uart.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      - Transmissão UART no USCI_A0, 115200 8N1, SMCLK.
+ *      - uart_write() apenas copia para o buffer circular e habilita a
+ *        IRQ de TX: a CPU acorda um instante por byte para recarregar
+ *        UCA0TXBUF e pode dormir em LPM0 enquanto o buffer esvazia.
+ *
+ *                MSP430G2553
+ *             -----------------
+ *            |     P1.2/UCA0TXD|----> RX
+ *
+ *                MSP430F247
+ *             -----------------
+ *            |     P3.4/UCA0TXD|----> RX
+ */
+
+/* System includes */
+#include <lib/uart.h>
+#include <msp430.h>
+#include <stdint.h>
+
+#if !defined(__MSP430F247__) && !defined(__MSP430G2553__)
+    #error "Library no supported/validated in this device."
+#endif
+
+#define UART_TX_MASK    (UART_TX_BUFFER_SIZE - 1)
+
+static volatile uint8_t tx_buffer[UART_TX_BUFFER_SIZE];
+/* head: written by uart_write(), tail: written by IRQ */
+static volatile uint8_t tx_head;
+static volatile uint8_t tx_tail;
+static volatile uint16_t tx_overflows;
+/* uart_flush() sleeping: wake it when the buffer empties */
+static volatile uint8_t tx_waiting;
+
+/**
+  * @brief  Divisor de 115200 baud para o SMCLK atual, modo de baixa
+  *         frequência: SMCLK / 115200 = UCBR + UCBRS / 8 (guia da
+  *         família, tabela de configurações típicas). USCI em reset.
+  *
+  * @param  Nenhum
+  *
+  * @retval Nenhum.
+  */
+static void uart_set_baud()
+{
+    switch (clock_get_mhz()) {
+    case 16:
+        UCA0BR0 = 138;
+        UCA0MCTL = UCBRS_7 + UCBRF_0;
+        break;
+    case 12:
+        UCA0BR0 = 104;
+        UCA0MCTL = UCBRS_1 + UCBRF_0;
+        break;
+    case 8:
+        UCA0BR0 = 69;
+        UCA0MCTL = UCBRS_4 + UCBRF_0;
+        break;
+    default:
+        UCA0BR0 = 8;
+        UCA0MCTL = UCBRS_6 + UCBRF_0;
+        break;
+    }
+    UCA0BR1 = 0;
+}
+
+void init_uart()
+{
+    /* TX pin as USCI_A0 */
+#if defined(__MSP430F247__)
+    P3SEL |= BIT4;
+#endif
+
+#if defined(__MSP430G2553__)
+    P1SEL |= BIT2;
+    P1SEL2 |= BIT2;
+#endif
+
+    /* Mantém controlador em reset, SMCLK */
+    UCA0CTL1 = UCSSEL_2 + UCSWRST;
+
+    uart_set_baud();
+
+    /* Clear SW reset, resume operation */
+    UCA0CTL1 &= ~UCSWRST;
+}
+
+/**
+  * @brief  Refaz o divisor de baud depois de clock_set_mhz(). Chamar
+  *         com a transmissão encerrada (uart_flush()): um byte em
+  *         recepção é perdido.
+  *
+  * @param  Nenhum
+  *
+  * @retval Nenhum.
+  */
+void uart_update_clock()
+{
+    /* UCSWRST clears the USCI_A0 interrupt enables */
+    uint8_t ie = IE2 & (UCA0RXIE + UCA0TXIE);
+
+    UCA0CTL1 |= UCSWRST;
+    uart_set_baud();
+    UCA0CTL1 &= ~UCSWRST;
+
+    IE2 |= ie;
+}
+
+/**
+  * @brief  Enfileira bytes para transmissão. Não bloqueia. Tudo ou
+  *         nada: parte de um quadro custaria ao receptor um erro de CRC
+  *         e uma ressincronização.
+  *
+  * @param  data: bytes a transmitir.
+  *         count: número de bytes.
+  *
+  * @retval count, ou 0 se não houver espaço no buffer para todos
+  *         (contabilizado em uart_tx_overflows()).
+  */
+uint8_t uart_write(const uint8_t *data, uint8_t count)
+{
+    uint8_t i;
+    /* tail only advances in the IRQ: free space only grows meanwhile */
+    uint8_t free = (uint8_t)((tx_tail - tx_head - 1) & UART_TX_MASK);
+
+    if (count > free) {
+        tx_overflows++;
+        return 0;
+    }
+
+    for (i=0; i < count; i++) {
+        tx_buffer[tx_head] = data[i];
+        tx_head = (tx_head + 1) & UART_TX_MASK;
+    }
+
+    /* IRQ fires as soon as TXBUF is empty */
+    IE2 |= UCA0TXIE;
+
+    return count;
+}
+
+/**
+  * @brief  Informa se ainda há bytes a transmitir: SMCLK deve
+  *         permanecer ligado (no máximo LPM0).
+  *
+  * @param  Nenhum
+  *
+  * @retval 1 se ocupado.
+  */
+uint8_t uart_tx_busy()
+{
+    return (tx_head != tx_tail) || (UCA0STAT & UCBUSY);
+}
+
+/**
+  * @brief  Espera em LPM0 o fim da transmissão: buffer vazio e último
+  *         byte fora do registrador de deslocamento.
+  *
+  * @param  Nenhum
+  *
+  * @retval Nenhum.
+  */
+void uart_flush()
+{
+    /* Test and sleep without a window for the last IRQ */
+    __disable_interrupt();
+    tx_waiting = 1;
+    while (tx_head != tx_tail) {
+        __bis_SR_register(LPM0_bits + GIE);
+        __disable_interrupt();
+    }
+    tx_waiting = 0;
+    __enable_interrupt();
+
+    /* Last character: about 87us */
+    while (UCA0STAT & UCBUSY);
+}
+
+uint16_t uart_tx_overflows()
+{
+    return tx_overflows;
+}
+
+/**
+  * @brief  Tratamento da IRQ de TX do USCI_A0. Chamada pela ISR
+  *         USCIAB0TX (usci_ab0_isr.c), compartilhada com USCI_B0.
+  *
+  * @param  Nenhum
+  *
+  * @retval 1 para acordar a CPU.
+  */
+uint8_t uart_tx_isr()
+{
+    if (tx_head == tx_tail) {
+        /* Buffer empty: stop IRQ */
+        IE2 &= ~UCA0TXIE;
+        return tx_waiting;
+    }
+
+    UCA0TXBUF = tx_buffer[tx_tail];
+    tx_tail = (tx_tail + 1) & UART_TX_MASK;
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+/*
+ * uart.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      USCI_A0 UART transmitter: bytes are queued in a ring buffer and
+ *      sent by the TX IRQ while the CPU sleeps.
+ */
+
+#ifndef LIB_UART_H_
+#define LIB_UART_H_
+
+#include <stdint.h>
+
+#include <lib/clock.h>
+
+/* Ring buffer size: power of two */
+#define UART_TX_BUFFER_SIZE     64
+
+#ifndef EXPORT_C
+#ifdef __cplusplus
+    #define EXPORT_C extern "C"
+#else
+    #define EXPORT_C
+#endif
+#endif
+
+EXPORT_C void init_uart();
+EXPORT_C void uart_update_clock();
+EXPORT_C uint8_t uart_write(const uint8_t *data, uint8_t count);
+EXPORT_C uint8_t uart_tx_busy();
+EXPORT_C void uart_flush();
+EXPORT_C uint16_t uart_tx_overflows();
+
+/* USCI_A0 TX IRQ handler: called by the shared USCIAB0TX ISR */
+EXPORT_C uint8_t uart_tx_isr();
+
+#endif /* LIB_UART_H_ */
@@ -0,0 +1,67 @@
+/*
+ *  usci_ab0_isr.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      - USCI_A0 (UART) e USCI_B0 (I2C) compartilham os vetores
+ *        USCIAB0TX e USCIAB0RX. As ISRs apenas despacham para os
+ *        tratadores de cada biblioteca, conforme flags habilitadas.
+ */
+
+/* System includes */
+#include <msp430.h>
+#include <stdint.h>
+
+/* Project includes */
+#include <lib/i2c_master_f247_g2xxx.h>
+#include <lib/uart.h>
+#include <lib/rs485.h>
+
+//******************************************************************************
+// USCI A0/B0 TX Interrupt: I2C data and UART TX *******************************
+//******************************************************************************
+
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector = USCIAB0TX_VECTOR
+__interrupt void USCIAB0TX_ISR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(USCIAB0TX_VECTOR))) USCIAB0TX_ISR (void)
+#else
+#error Compiler not supported!
+#endif
+{
+    uint8_t wake = 0;
+
+    if (((IFG2 & UCB0TXIFG) && (IE2 & UCB0TXIE)) || ((IFG2 & UCB0RXIFG) && (IE2 & UCB0RXIE)))
+        wake |= i2c_master_data_isr();
+
+    if ((IFG2 & UCA0TXIFG) && (IE2 & UCA0TXIE))
+        wake |= uart_tx_isr();
+
+    if (wake)
+        __bic_SR_register_on_exit(CPUOFF);      // Exit LPM0
+}
+
+//******************************************************************************
+// USCI A0/B0 RX Interrupt: I2C start, stop and NACK, UART RX ******************
+//******************************************************************************
+
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector = USCIAB0RX_VECTOR
+__interrupt void USCIAB0RX_ISR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(USCIAB0RX_VECTOR))) USCIAB0RX_ISR (void)
+#else
+#error Compiler not supported!
+#endif
+{
+    if ((IFG2 & UCA0RXIFG) && (IE2 & UCA0RXIE)) {
+        /* Node may be in LPM3 waiting for a poll */
+        if (rs485_rx_isr())
+            __bic_SR_register_on_exit(LPM3_bits);
+    }
+
+    if (i2c_master_state_isr())
+        __bic_SR_register_on_exit(CPUOFF);      // Exit LPM0
+}
@@ -0,0 +1,207 @@
+/*
+ * Dht22Model.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include "Dht22Model.h"
+
+#define US(x)   ((uint64_t)(x) * DHT22_MODEL_CYCLES_PER_US)
+
+/* Start signal detected by the sensor */
+#define DHT22_START_MIN_US      800
+
+/* Datasheet timings (us): min, model nominal, max */
+const Dht22Model::Timing Dht22Model::response_delay = { 20, 20, 200 };
+const Dht22Model::Timing Dht22Model::response_low   = { 75, 80, 85 };
+const Dht22Model::Timing Dht22Model::response_high  = { 75, 80, 85 };
+const Dht22Model::Timing Dht22Model::bit_low        = { 48, 50, 55 };
+const Dht22Model::Timing Dht22Model::bit_0_high     = { 22, 27, 30 };
+const Dht22Model::Timing Dht22Model::bit_1_high     = { 68, 70, 75 };
+const Dht22Model::Timing Dht22Model::end_low        = { 45, 50, 55 };
+
+Dht22Model::Dht22Model(uint8_t port, uint8_t mask) :
+    temperature(25.0), humidity(50.0), timing_spread(false), jitter_us(0),
+    glitch_rate(0), glitch_us(2.0), checksum_error_rate(0), missing(false),
+    reads(0), early_starts(0), glitches(0), corrupted(0), sent(), my_port(port), my_mask(mask),
+    last_access(0), low_since(0), driven_low(false), edge(0),
+    power_port(0), power_mask(0), powered(true), power_since(0), power_access(0),
+    on_cycles(0)
+{
+}
+
+/**
+ * @brief  Supply the sensor from an output pin: off until it is driven
+ *         high.
+ * @param  port: port number.
+ *         mask: pin bit.
+ *
+ * @retval Nenhum.
+ */
+void Dht22Model::power_pin(uint8_t port, uint8_t mask)
+{
+    power_port = port;
+    power_mask = mask;
+    powered = false;
+}
+
+uint64_t Dht22Model::powered_cycles(uint64_t now) const
+{
+    return on_cycles + (powered ? now - power_since : 0);
+}
+
+static uint16_t to_tenths(double value)
+{
+    return (uint16_t)(value * 10.0 + 0.5);
+}
+
+void Dht22Model::frame(uint8_t data[5])
+{
+    uint16_t h = to_tenths(humidity);
+    uint16_t t = temperature < 0 ? to_tenths(-temperature) | 0x8000 : to_tenths(temperature);
+
+    data[0] = h >> 8;
+    data[1] = h;
+    data[2] = t >> 8;
+    data[3] = t;
+    data[4] = data[0] + data[1] + data[2] + data[3];
+}
+
+/* Width of one pulse of this read, us */
+double Dht22Model::width(const Timing &timing)
+{
+    double us = timing.typ_us;
+
+    if (timing_spread)
+        us = std::uniform_real_distribution<double>(timing.min_us, timing.max_us)(rng);
+
+    if (jitter_us > 0)
+        us += std::normal_distribution<double>(0.0, jitter_us)(rng);
+
+    return us < 1.0 ? 1.0 : us;
+}
+
+/**
+ * @brief  Append a pulse of us microseconds ending at an edge. A glitch
+ *         splits it: the opposite level for glitch_us somewhere inside.
+ */
+void Dht22Model::segment(uint64_t *t, double us, bool glitch)
+{
+    uint64_t length = (uint64_t)(us * DHT22_MODEL_CYCLES_PER_US + 0.5);
+    uint64_t width = (uint64_t)(glitch_us * DHT22_MODEL_CYCLES_PER_US + 0.5);
+    uint64_t start;
+
+    if (glitch && width + 2 < length) {
+        start = std::uniform_int_distribution<uint64_t>(1, length - width - 1)(rng);
+        edges.push_back(*t + start);
+        edges.push_back(*t + start + width);
+        glitches++;
+    }
+
+    *t += length;
+    edges.push_back(*t);
+}
+
+void Dht22Model::respond(uint64_t release)
+{
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    uint64_t t = release;
+    uint8_t i, one;
+
+    edges.clear();
+    if (missing)
+        return;
+
+    frame(sent);
+    if (checksum_error_rate > 0 && uniform(rng) < checksum_error_rate) {
+        sent[4] ^= 1 << std::uniform_int_distribution<int>(0, 7)(rng);
+        corrupted++;
+    }
+
+    segment(&t, width(response_delay), false);
+    segment(&t, width(response_low), false);
+    segment(&t, width(response_high), false);
+
+    for (i=0; i < DHT22_MODEL_BITS; i++) {
+        one = sent[i / 8] & (0x80 >> (i % 8));
+
+        segment(&t, width(bit_low), glitch_rate > 0 && uniform(rng) < glitch_rate / 2);
+        segment(&t, width(one ? bit_1_high : bit_0_high), glitch_rate > 0 && uniform(rng) < glitch_rate / 2);
+    }
+
+    /* Last low, then the sensor releases the line */
+    segment(&t, width(end_low), false);
+}
+
+/* Sensor output at cycle now: 1 released, 0 pulling low */
+uint8_t Dht22Model::level(uint64_t now)
+{
+    while (edge < edges.size() && edges[edge] <= now)
+        edge++;
+
+    /* Before the first edge and after the last: released */
+    return !(edge & 1);
+}
+
+/**
+ * @brief  Port hook: track the start signal and drive PxIN.
+ * @param  mcu: context.
+ *         port: port being accessed.
+ *
+ * @retval Nenhum.
+ */
+void Dht22Model::update(host_mcu_t *mcu, uint8_t port)
+{
+    uint8_t mcu_low;
+    bool on;
+
+    /* Supply pin: written by the previous access to its port */
+    if (power_mask) {
+        on = (mcu->port_dir[power_port] & power_mask) && (mcu->port_out[power_port] & power_mask);
+        if (on && !powered)
+            power_since = power_access;
+        else if (!on && powered)
+            on_cycles += power_access - power_since;
+        powered = on;
+        if (port == power_port)
+            power_access = mcu->cycles;
+    }
+
+    if (port != my_port)
+        return;
+
+    /* Pin state since the previous access */
+    mcu_low = (mcu->port_dir[port] & my_mask) && !(mcu->port_out[port] & my_mask);
+
+    if (mcu_low && !driven_low) {
+        driven_low = true;
+        low_since = last_access;
+    }
+    else if (!mcu_low && driven_low) {
+        driven_low = false;
+        /* Released right after the previous access. A low held while
+         * unpowered is the line parked by power_off(), not a start */
+        if (last_access - low_since >= US(DHT22_START_MIN_US) &&
+            (!power_mask || low_since >= power_since)) {
+            if (!power_mask || (powered && last_access - power_since >= US(DHT22_MODEL_WARMUP_US))) {
+                reads++;
+                edge = 0;
+                respond(last_access);
+            }
+            else {
+                early_starts++;
+                edges.clear();
+                edge = 0;
+            }
+        }
+    }
+
+    last_access = mcu->cycles;
+
+    /* Open drain: low if anybody pulls low, or the pull-up is off */
+    if (mcu_low || !powered || !level(mcu->cycles))
+        mcu->port_in[port] &= ~my_mask;
+    else
+        mcu->port_in[port] |= my_mask;
+}
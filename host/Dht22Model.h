@@ -0,0 +1,117 @@
+/*
+ * Dht22Model.h : DHT22/AM2302 single-wire sensor on a host port pin
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Call update() from the port hook of the context. The model sees the
+ *      pin state before every port access, so it knows how long the MCU
+ *      held the line low. When a start signal (>= 800us low) is released
+ *      it answers with the datasheet waveform against the virtual cycle
+ *      counter: response low/high, then 40 bits of 50us low followed by
+ *      27us (0) or 70us (1) high, MSB first. The line idles high (pull-up).
+ *
+ *      Faults for decoder tests, all off by default: pulse widths drawn
+ *      in the datasheet range on each read, gaussian jitter on every
+ *      pulse, glitches (a short pulse of the opposite level inside a bit),
+ *      corrupted checksums and a missing sensor. Random draws only happen
+ *      for the faults enabled.
+ *
+ *      With power_pin() the sensor is supplied by an MCU pin: unpowered it
+ *      pulls the line low (pull-up on its supply) and it ignores start
+ *      signals until DHT22_MODEL_WARMUP_US after power-up.
+ */
+
+#ifndef HOST_DHT22MODEL_H_
+#define HOST_DHT22MODEL_H_
+
+#include <msp430.h>
+#include <stdint.h>
+
+#include <random>
+#include <vector>
+
+/* Host MCLK: 16MHz */
+#define DHT22_MODEL_CYCLES_PER_US   16
+#define DHT22_MODEL_BITS            40
+
+/* Datasheet: no start signal within 1s of power-up */
+#define DHT22_MODEL_WARMUP_US       1000000
+
+class Dht22Model
+{
+public:
+    Dht22Model(uint8_t port, uint8_t mask);
+    virtual ~Dht22Model() {}
+
+    void update(host_mcu_t *mcu, uint8_t port);
+
+    void seed(uint32_t value) { rng.seed(value); }
+
+    /* Supply switched by an output pin, high: on */
+    void power_pin(uint8_t port, uint8_t mask);
+    /* Cycles powered up to now, power_pin() or not */
+    uint64_t powered_cycles(uint64_t now) const;
+
+    /* Ambient seen by the sensor: oC and %RH */
+    double temperature;
+    double humidity;
+
+    /* Faults */
+    bool timing_spread;             /* pulse widths anywhere in the datasheet range */
+    double jitter_us;               /* sigma added to every pulse width */
+    double glitch_rate;             /* probability of a glitch per bit */
+    double glitch_us;               /* glitch width */
+    double checksum_error_rate;     /* probability of a bad checksum per read */
+    bool missing;                   /* start signals are not answered */
+
+    /* Number of start signals answered, and ignored in warm-up */
+    uint32_t reads;
+    uint32_t early_starts;
+    uint32_t glitches;
+    uint32_t corrupted;
+
+    /* Last frame sent: humidity, temperature, checksum as sent */
+    uint8_t sent[5];
+
+protected:
+    /* Sensor data: humidity, temperature (sign and magnitude), checksum */
+    virtual void frame(uint8_t data[5]);
+    /* Build the answer to a start signal released at cycle release */
+    virtual void respond(uint64_t release);
+
+    /* Line transitions after release: even index -> low, odd -> high */
+    std::vector<uint64_t> edges;
+
+    std::mt19937 rng;
+
+private:
+    struct Timing {
+        double min_us, typ_us, max_us;
+    };
+
+    double width(const Timing &timing);
+    void segment(uint64_t *t, double us, bool glitch);
+    uint8_t level(uint64_t now);
+
+    static const Timing response_delay, response_low, response_high;
+    static const Timing bit_low, bit_0_high, bit_1_high, end_low;
+
+    uint8_t my_port;
+    uint8_t my_mask;
+
+    uint64_t last_access;
+    uint64_t low_since;
+    bool driven_low;
+    size_t edge;
+
+    uint8_t power_port;
+    uint8_t power_mask;
+    bool powered;
+    uint64_t power_since;
+    /* Last access to power_port */
+    uint64_t power_access;
+    uint64_t on_cycles;
+};
+
+#endif /* HOST_DHT22MODEL_H_ */
@@ -0,0 +1,217 @@
+/*
+ * HygroModels.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <string.h>
+
+#include <lib/crc.h>
+#include "HygroModels.h"
+
+static uint16_t clamp_raw(double raw)
+{
+    if (raw < 0)
+        return 0;
+    if (raw > 65535)
+        return 65535;
+
+    return (uint16_t)(raw + 0.5);
+}
+
+bool Sht3xModel::write(const uint8_t *data, uint8_t count)
+{
+    /* Single shot, high repeatability, no clock stretching */
+    if (count == 2 && data[0] == 0x24 && data[1] == 0x00) {
+        ready = true;
+        return true;
+    }
+
+    return false;
+}
+
+bool Sht3xModel::read(uint8_t *data, uint8_t count)
+{
+    uint16_t t_raw = clamp_raw((temperature + 45.0) * 65535.0 / 175.0);
+    uint16_t h_raw = clamp_raw(humidity * 65535.0 / 100.0);
+    uint8_t frame[6];
+
+    /* No measurement pending: read header is NACKed */
+    if (!ready)
+        return false;
+
+    ready = false;
+
+    frame[0] = t_raw >> 8;
+    frame[1] = t_raw;
+    frame[2] = crc8_sensirion(frame, 2);
+    frame[3] = h_raw >> 8;
+    frame[4] = h_raw;
+    frame[5] = crc8_sensirion(frame + 3, 2);
+
+    memcpy(data, frame, count < sizeof(frame) ? count : sizeof(frame));
+
+    return true;
+}
+
+bool Hdc1080Model::write(const uint8_t *data, uint8_t count)
+{
+    if (!count)
+        return true;
+
+    pointer = data[0];
+
+    if (pointer == 0x02 && count >= 3)
+        config = data[1] << 8 | data[2];
+
+    /* Pointer to temperature register starts an acquisition */
+    if (pointer == 0x00 && count == 1)
+        ready = true;
+
+    return true;
+}
+
+bool Hdc1080Model::read(uint8_t *data, uint8_t count)
+{
+    uint16_t value[2];
+    uint8_t i;
+
+    if (pointer == 0x00) {
+        if (!ready)
+            return false;
+        ready = false;
+        value[0] = clamp_raw((temperature + 40.0) * 65536.0 / 165.0);
+        value[1] = clamp_raw(humidity * 65536.0 / 100.0);
+    }
+    else {
+        switch (pointer) {
+        case 0x02: value[0] = config; break;
+        case 0xFE: value[0] = 0x5449; break;
+        case 0xFF: value[0] = 0x1050; break;
+        default:   value[0] = 0; break;
+        }
+        value[1] = 0;
+    }
+
+    for (i = 0; i < count && i < 4; i++)
+        data[i] = value[i >> 1] >> ((i & 1) ? 0 : 8);
+
+    return true;
+}
+
+Bme280Model::Bme280Model(uint8_t addr) : HygroModel(addr), pointer(0)
+{
+    /* Typical trimming parameters */
+    const uint8_t calib_t[6] = { 0x70, 0x6B, 0x43, 0x67, 0x18, 0xFC };  /* 27504, 26435, -1000 */
+    const uint8_t calib_h[7] = { 0x6A, 0x01, 0x00, 0x14, 0x04, 0x00, 0x1E }; /* 362, 0, 324, 0, 30 */
+
+    memset(regs, 0, sizeof(regs));
+    memcpy(regs + 0x88, calib_t, sizeof(calib_t));
+    regs[0xA1] = 75;
+    memcpy(regs + 0xE1, calib_h, sizeof(calib_h));
+    regs[0xD0] = 0x60;
+
+    /* Reset values of data registers: measurement skipped */
+    regs[0xFA] = 0x80;
+    regs[0xFD] = 0x80;
+}
+
+bool Bme280Model::write(const uint8_t *data, uint8_t count)
+{
+    uint8_t i;
+
+    if (!count)
+        return true;
+
+    /* Register address only: read pointer */
+    pointer = data[0];
+
+    /* Register address and value pairs */
+    for (i = 0; i + 1 < count; i += 2) {
+        regs[data[i]] = data[i + 1];
+
+        if (data[i] == 0xF4 && (data[i + 1] & 0x03) == 0x01)
+            convert();
+    }
+
+    return true;
+}
+
+bool Bme280Model::read(uint8_t *data, uint8_t count)
+{
+    uint8_t i;
+
+    for (i = 0; i < count; i++)
+        data[i] = regs[(uint8_t)(pointer + i)];
+
+    return true;
+}
+
+double Bme280Model::compensate_t(int32_t adc_T, double *t_fine)
+{
+    double dig_T1 = (uint16_t)(regs[0x89] << 8 | regs[0x88]);
+    double dig_T2 = (int16_t)(regs[0x8B] << 8 | regs[0x8A]);
+    double dig_T3 = (int16_t)(regs[0x8D] << 8 | regs[0x8C]);
+    double var1, var2;
+
+    var1 = (adc_T / 16384.0 - dig_T1 / 1024.0) * dig_T2;
+    var2 = (adc_T / 131072.0 - dig_T1 / 8192.0) * (adc_T / 131072.0 - dig_T1 / 8192.0) * dig_T3;
+    *t_fine = var1 + var2;
+
+    return *t_fine / 5120.0;
+}
+
+double Bme280Model::compensate_h(int32_t adc_H, double t_fine)
+{
+    double dig_H1 = regs[0xA1];
+    double dig_H2 = (int16_t)(regs[0xE2] << 8 | regs[0xE1]);
+    double dig_H3 = regs[0xE3];
+    double dig_H4 = (int16_t)((int8_t)regs[0xE4] * 16 | (regs[0xE5] & 0x0F));
+    double dig_H5 = (int16_t)((int8_t)regs[0xE6] * 16 | (regs[0xE5] >> 4));
+    double dig_H6 = (int8_t)regs[0xE7];
+    double h;
+
+    h = t_fine - 76800.0;
+    h = (adc_H - (dig_H4 * 64.0 + dig_H5 / 16384.0 * h)) *
+        (dig_H2 / 65536.0 * (1.0 + dig_H6 / 67108864.0 * h * (1.0 + dig_H3 / 67108864.0 * h)));
+    h = h * (1.0 - dig_H1 * h / 524288.0);
+
+    if (h > 100.0)
+        h = 100.0;
+    if (h < 0.0)
+        h = 0.0;
+
+    return h;
+}
+
+/* Find the raw codes that compensate to the model ambient (both monotonic) */
+void Bme280Model::convert()
+{
+    int32_t lo = 0, hi = (1 << 20) - 1, mid;
+    double t_fine;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (compensate_t(mid, &t_fine) < temperature)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    regs[0xFA] = lo >> 12;
+    regs[0xFB] = lo >> 4;
+    regs[0xFC] = (lo & 0x0F) << 4;
+    compensate_t(lo, &t_fine);
+
+    lo = 0;
+    hi = 65535;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (compensate_h(mid, t_fine) < humidity)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    regs[0xFD] = lo >> 8;
+    regs[0xFE] = lo;
+}
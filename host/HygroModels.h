@@ -0,0 +1,76 @@
+/*
+ * HygroModels.h : I2C humidity sensors simulated on the host bus
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Each model answers like the real device for the commands used by
+ *      the CPP drivers and reports the temperature/humidity set by the
+ *      user. The conversions back to raw codes use the datasheet formulas
+ *      in double precision, independent of the firmware integer math.
+ */
+
+#ifndef HOST_HYGROMODELS_H_
+#define HOST_HYGROMODELS_H_
+
+#include <stdint.h>
+
+#include "I2cSlave.h"
+
+class HygroModel: public I2cSlave
+{
+public:
+    HygroModel(uint8_t addr) : I2cSlave(addr), temperature(25.0), humidity(50.0) {}
+
+    /* Ambient seen by the sensor: oC and %RH */
+    double temperature;
+    double humidity;
+};
+
+/* Sensirion SHT3x: single shot measurement, 6 bytes result with CRC */
+class Sht3xModel: public HygroModel
+{
+public:
+    Sht3xModel(uint8_t addr) : HygroModel(addr), ready(false) {}
+
+    bool write(const uint8_t *data, uint8_t count);
+    bool read(uint8_t *data, uint8_t count);
+
+private:
+    bool ready;
+};
+
+/* TI HDC1080: pointer write to 0x00 triggers T and RH acquisition */
+class Hdc1080Model: public HygroModel
+{
+public:
+    Hdc1080Model(uint8_t addr) : HygroModel(addr), pointer(0), config(0x1000), ready(false) {}
+
+    bool write(const uint8_t *data, uint8_t count);
+    bool read(uint8_t *data, uint8_t count);
+
+private:
+    uint8_t pointer;
+    uint16_t config;
+    bool ready;
+};
+
+/* Bosch BME280: register file, forced mode conversion */
+class Bme280Model: public HygroModel
+{
+public:
+    Bme280Model(uint8_t addr);
+
+    bool write(const uint8_t *data, uint8_t count);
+    bool read(uint8_t *data, uint8_t count);
+
+private:
+    uint8_t regs[256];
+    uint8_t pointer;
+
+    void convert();
+    double compensate_t(int32_t adc_T, double *t_fine);
+    double compensate_h(int32_t adc_H, double t_fine);
+};
+
+#endif /* HOST_HYGROMODELS_H_ */
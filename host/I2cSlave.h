@@ -0,0 +1,36 @@
+/*
+ * I2cSlave.h : device model on the host I2C bus
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      i2c_host.cpp implements the lib/i2c_master_f247_g2xxx API on host:
+ *      each transfer is delivered to the slave attached to the current
+ *      host_mcu with the matching address and costs the bus time of a
+ *      100kHz transfer in virtual cycles.
+ */
+
+#ifndef HOST_I2CSLAVE_H_
+#define HOST_I2CSLAVE_H_
+
+#include <stdint.h>
+
+class I2cSlave
+{
+public:
+    I2cSlave(uint8_t addr) : address(addr), next(0) {}
+    virtual ~I2cSlave() {}
+
+    /* One write transfer: bytes after the address byte. false: NACK */
+    virtual bool write(const uint8_t *data, uint8_t count) = 0;
+    /* One read transfer. false: NACK */
+    virtual bool read(uint8_t *data, uint8_t count) = 0;
+
+    uint8_t address;
+    I2cSlave *next;
+};
+
+/* Attach slave to the bus of the current host_mcu */
+void host_i2c_attach(I2cSlave *slave);
+
+#endif /* HOST_I2CSLAVE_H_ */
@@ -0,0 +1,115 @@
+/*
+ * Ssd1306Model.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <string.h>
+
+#include "Ssd1306Model.h"
+
+Ssd1306Model::Ssd1306Model(uint8_t addr) :
+    I2cSlave(addr), display_on(false), data_bytes(0), cmd(0), arg_count(0),
+    arg_needed(0), col_start(0), col_end(SSD1306_MODEL_WIDTH - 1), col(0),
+    page_start(0), page_end(SSD1306_MODEL_PAGES - 1), page(0)
+{
+    memset(gddram, 0, sizeof(gddram));
+}
+
+bool Ssd1306Model::write(const uint8_t *data, uint8_t count)
+{
+    uint8_t i;
+
+    if (!count)
+        return true;
+
+    /* Control byte: D/C# bit selects data or commands for the rest */
+    for (i=1; i < count; i++) {
+        if (data[0] & 0x40)
+            this->data(data[i]);
+        else
+            command(data[i]);
+    }
+
+    return true;
+}
+
+bool Ssd1306Model::read(uint8_t *data, uint8_t count)
+{
+    /* Status byte: display off bit */
+    if (count)
+        data[0] = display_on ? 0x00 : 0x40;
+
+    return true;
+}
+
+uint8_t Ssd1306Model::pixel(uint8_t x, uint8_t y) const
+{
+    return (gddram[y / 8][x] >> (y % 8)) & 1;
+}
+
+static uint8_t argument_count(uint8_t cmd)
+{
+    switch (cmd) {
+    case 0x21:  /* column range */
+    case 0x22:  /* page range */
+        return 2;
+    case 0x20:  /* addressing mode */
+    case 0x81:  /* contrast */
+    case 0x8D:  /* charge pump */
+    case 0xA8:  /* mux ratio */
+    case 0xD3:  /* display offset */
+    case 0xD5:  /* clock divide */
+    case 0xD9:  /* pre-charge */
+    case 0xDA:  /* COM pins */
+    case 0xDB:  /* VCOMH */
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+void Ssd1306Model::command(uint8_t byte)
+{
+    if (arg_needed) {
+        args[arg_count++] = byte;
+        if (arg_count < arg_needed)
+            return;
+
+        arg_needed = 0;
+
+        if (cmd == 0x21) {
+            col_start = col = args[0] & 0x7F;
+            col_end = args[1] & 0x7F;
+        }
+        else if (cmd == 0x22) {
+            page_start = page = args[0] & 0x07;
+            page_end = args[1] & 0x07;
+        }
+        return;
+    }
+
+    cmd = byte;
+    arg_count = 0;
+    arg_needed = argument_count(byte);
+
+    if (byte == 0xAF)
+        display_on = true;
+    else if (byte == 0xAE)
+        display_on = false;
+}
+
+void Ssd1306Model::data(uint8_t byte)
+{
+    gddram[page][col] = byte;
+    data_bytes++;
+
+    /* Horizontal addressing: next column, wrap to the next page */
+    if (col == col_end) {
+        col = col_start;
+        page = page == page_end ? page_start : (page + 1) & 0x07;
+    }
+    else
+        col = (col + 1) & 0x7F;
+}
@@ -0,0 +1,53 @@
+/*
+ * Ssd1306Model.h : SSD1306 OLED controller on the host I2C bus
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Keeps the 128x64 display RAM written by the CPP SSD1306 class:
+ *      command stream (control byte 0x00/0x80) with the horizontal
+ *      addressing mode and its column/page ranges, and data stream
+ *      (control byte 0x40). Other commands only consume their arguments.
+ */
+
+#ifndef HOST_SSD1306MODEL_H_
+#define HOST_SSD1306MODEL_H_
+
+#include <stdint.h>
+
+#include "I2cSlave.h"
+
+#define SSD1306_MODEL_WIDTH     128
+#define SSD1306_MODEL_PAGES     8
+
+class Ssd1306Model: public I2cSlave
+{
+public:
+    Ssd1306Model(uint8_t addr);
+
+    bool write(const uint8_t *data, uint8_t count);
+    bool read(uint8_t *data, uint8_t count);
+
+    /* Pixel (x, y) of the display RAM: 1 lit */
+    uint8_t pixel(uint8_t x, uint8_t y) const;
+
+    /* Display RAM: page major, one byte is 8 vertical pixels */
+    uint8_t gddram[SSD1306_MODEL_PAGES][SSD1306_MODEL_WIDTH];
+    bool display_on;
+    uint32_t data_bytes;
+
+private:
+    void command(uint8_t byte);
+    void data(uint8_t byte);
+
+    /* Command waiting for arguments */
+    uint8_t cmd;
+    uint8_t args[2];
+    uint8_t arg_count;
+    uint8_t arg_needed;
+
+    uint8_t col_start, col_end, col;
+    uint8_t page_start, page_end, page;
+};
+
+#endif /* HOST_SSD1306MODEL_H_ */
@@ -0,0 +1,249 @@
+/*
+ * draw_bench.cpp : host micro-benchmarks of the SSD1306 draw path
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      g++ -std=c++14 -O2 -DSSD1306_COUNT_OPS -D__MSP430G2553__ -I host -I CPP \
+ *          -o th-draw-bench host/bench/draw_bench.cpp CPP/SSD1306.cpp \
+ *          CPP/MainScreen.cpp -x c CPP/lib/format.c CPP/bench/i2c_null.c
+ *
+ *      Use -D__MSP430F247__ for the 1KB frame buffer of the F247.
+ *
+ *      th-draw-bench [--filter=text] [--min-time=seconds] [--repetitions=n]
+ *
+ *      Each benchmark is a function running state.iterations operations;
+ *      the iteration count grows until a run lasts --min-time and the
+ *      best of --repetitions runs is reported, in ns per operation. The
+ *      ops/frame column is how many times the main screen (MainScreen)
+ *      calls the primitive per frame, nested calls included, counted by
+ *      the SSD1306_COUNT_OPS build. I2C transfers are bench/i2c_null.c:
+ *      Refresh is the CPU side only.
+ *
+ *      Host numbers do not predict MSP430 cycles (CPP/bench/run_cycles.sh
+ *      does); they are for iterating on the algorithms.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <vector>
+
+#include "SSD1306.h"
+#include "MainScreen.h"
+
+#define BENCH_MIN_TIME      0.2
+#define BENCH_REPETITIONS   3
+
+#if defined(__MSP430G2553__)
+#define BENCH_FRAME_BUFFER  "256 byte band (G2553)"
+#else
+#define BENCH_FRAME_BUFFER  "1KB (F247)"
+#endif
+
+class State
+{
+public:
+    uint64_t iterations;
+};
+
+struct Benchmark {
+    const char *name;
+    void (*fn)(State &state);
+    /* Calls per main screen frame, from SSD1306::op_count */
+    uint32_t SSD1306::op_count_t::*per_frame;
+};
+
+static std::vector<Benchmark> &benchmarks()
+{
+    static std::vector<Benchmark> list;
+
+    return list;
+}
+
+struct Registrar {
+    Registrar(const char *name, void (*fn)(State &), uint32_t SSD1306::op_count_t::*per_frame)
+    {
+        benchmarks().push_back(Benchmark{ name, fn, per_frame });
+    }
+};
+
+#define BENCHMARK(fn, per_frame) static Registrar registrar_##fn(#fn, fn, per_frame)
+
+/* Keep the compiler from dropping work whose result is not used */
+template <class T>
+static inline void do_not_optimize(T &value)
+{
+    __asm__ __volatile__ ("" : : "r"(&value) : "memory");
+}
+
+static uint64_t now_ns()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static SSD1306 oled(0x3C);
+static MainScreen screen(oled);
+
+static void DrawPixel(State &state)
+{
+    for (uint64_t i=0; i < state.iterations; i++)
+        oled.DrawPixel(i & 127, (i >> 7) & 15, (i & 256) ? SSD1306::BLACK_PIXEL : SSD1306::WHITE_PIXEL);
+    do_not_optimize(oled);
+}
+BENCHMARK(DrawPixel, &SSD1306::op_count_t::pixel);
+
+static void WriteLine(State &state)
+{
+    for (uint64_t i=0; i < state.iterations; i++)
+        oled.WriteLine(0, 0, 127, 15, SSD1306::WHITE_PIXEL);
+    do_not_optimize(oled);
+}
+BENCHMARK(WriteLine, &SSD1306::op_count_t::line);
+
+static void FillRect(State &state)
+{
+    for (uint64_t i=0; i < state.iterations; i++)
+        oled.FillRect(32, 0, 16, 16, SSD1306::WHITE_PIXEL);
+    do_not_optimize(oled);
+}
+BENCHMARK(FillRect, &SSD1306::op_count_t::rect);
+
+static void WriteScaledChar_1(State &state)
+{
+    for (uint64_t i=0; i < state.iterations; i++)
+        oled.WriteScaledChar(32, 8, '0' + (i % 10), 1);
+    do_not_optimize(oled);
+}
+BENCHMARK(WriteScaledChar_1, &SSD1306::op_count_t::scaled_char);
+
+static void WriteScaledChar_2(State &state)
+{
+    for (uint64_t i=0; i < state.iterations; i++)
+        oled.WriteScaledChar(32, 0, '0' + (i % 10), 2);
+    do_not_optimize(oled);
+}
+BENCHMARK(WriteScaledChar_2, &SSD1306::op_count_t::scaled_char);
+
+static void ClearFrameBuffer(State &state)
+{
+    for (uint64_t i=0; i < state.iterations; i++) {
+        oled.ClearFrameBuffer();
+        do_not_optimize(oled);
+    }
+}
+BENCHMARK(ClearFrameBuffer, &SSD1306::op_count_t::clear);
+
+static void Refresh(State &state)
+{
+    for (uint64_t i=0; i < state.iterations; i++)
+        oled.Refresh(SSD1306::LINE_1);
+}
+BENCHMARK(Refresh, &SSD1306::op_count_t::refresh);
+
+static void MainScreenFrame(State &state)
+{
+    for (uint64_t i=0; i < state.iterations; i++)
+        screen.show(200 + (i % 100), 550, 33);
+    do_not_optimize(oled);
+}
+BENCHMARK(MainScreenFrame, NULL);
+
+/**
+ * @brief  Time one benchmark.
+ * @retval Best ns per operation of the repetitions.
+ */
+static double run(const Benchmark &b, double min_time, int repetitions, uint64_t *iterations)
+{
+    State state;
+    uint64_t t0, elapsed;
+    double best = 0, ns;
+    int r;
+
+    /* Grow the run until it lasts a tenth of min_time, then scale */
+    state.iterations = 1;
+    while (1) {
+        t0 = now_ns();
+        b.fn(state);
+        elapsed = now_ns() - t0;
+
+        if (elapsed >= min_time * 1e8 || state.iterations >= (1ULL << 40))
+            break;
+        state.iterations *= 2;
+    }
+    state.iterations = (uint64_t)(state.iterations * (min_time * 1e9 / (elapsed ? elapsed : 1)));
+    if (!state.iterations)
+        state.iterations = 1;
+
+    for (r=0; r < repetitions; r++) {
+        t0 = now_ns();
+        b.fn(state);
+        ns = (double)(now_ns() - t0) / state.iterations;
+
+        if (r == 0 || ns < best)
+            best = ns;
+    }
+
+    *iterations = state.iterations;
+
+    return best;
+}
+
+static int usage()
+{
+    fprintf(stderr, "usage: th-draw-bench [--filter=text] [--min-time=seconds] [--repetitions=n]\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = NULL;
+    double min_time = BENCH_MIN_TIME;
+    int repetitions = BENCH_REPETITIONS;
+    SSD1306::op_count_t frame;
+    uint64_t iterations;
+    double ns;
+    int i;
+
+    for (i=1; i < argc; i++) {
+        if (strncmp(argv[i], "--filter=", 9) == 0)
+            filter = argv[i] + 9;
+        else if (strncmp(argv[i], "--min-time=", 11) == 0)
+            min_time = atof(argv[i] + 11);
+        else if (strncmp(argv[i], "--repetitions=", 14) == 0)
+            repetitions = atoi(argv[i] + 14);
+        else
+            return usage();
+    }
+    if (min_time <= 0 || repetitions < 1)
+        return usage();
+
+    /* Primitive calls of one main screen frame */
+    memset(&SSD1306::op_count, 0, sizeof(SSD1306::op_count));
+    screen.show(235, 550, 33);
+    frame = SSD1306::op_count;
+
+    printf("frame buffer: %s\n\n", BENCH_FRAME_BUFFER);
+    printf("%-20s %12s %14s %10s\n", "Benchmark", "ns/op", "Iterations", "ops/frame");
+
+    for (auto &b : benchmarks()) {
+        if (filter && !strstr(b.name, filter))
+            continue;
+
+        ns = run(b, min_time, repetitions, &iterations);
+
+        if (b.per_frame)
+            printf("%-20s %12.1f %14llu %10u\n", b.name, ns, (unsigned long long)iterations, frame.*b.per_frame);
+        else
+            printf("%-20s %12.1f %14llu %10u\n", b.name, ns, (unsigned long long)iterations, 1);
+    }
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+/*
+ * clock_host.cpp : host implementation of lib/clock
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      MCLK is host_mcu->mclk_mhz: CPU cycles of the mock scale with it
+ *      and the time spent at each clock is accounted on every change.
+ */
+
+#include <msp430.h>
+
+#include <lib/clock.h>
+
+uint8_t clock_set_mhz(uint8_t mhz)
+{
+    if (mhz > HOST_MCLK_MHZ || (mhz != 1 && mhz != 8 && mhz != 12 && mhz != 16))
+        return 0;
+
+    host_mclk_account(host_mcu);
+    host_mcu->mclk_mhz = mhz;
+
+    return 1;
+}
+
+uint8_t clock_get_mhz()
+{
+    return host_mcu->mclk_mhz ? host_mcu->mclk_mhz : HOST_MCLK_MHZ;
+}
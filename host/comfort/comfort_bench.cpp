@@ -0,0 +1,227 @@
+/*
+ * comfort_bench.cpp : accuracy and speed of the fixed-point comfort metrics
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      g++ -std=c++14 -O2 -I host -I CPP -o th-comfort-bench \
+ *          host/comfort/comfort_bench.cpp CPP/Comfort.cpp -x c CPP/lib/format.c
+ *
+ *      th-comfort-bench [-t min:max] [-h min:max]
+ *
+ *      Evaluates Comfort::dew_point(), absolute_humidity() and heat_index()
+ *      on every DHT22 reading (0.1oC, 0.1 %RH steps) of the range, default
+ *      -20 to 60oC and 1 to 100 %RH, starting from the tenths the sensor
+ *      gives as the firmware does. Each result is compared with the same
+ *      formula in double precision on the same Q8 inputs. The heat index
+ *      is compared with plain NWS, which steps from Steadman to Rothfusz,
+ *      from 26 to 50oC and below 100oC, where Celsius does not saturate.
+ *      Readings within the blend band of Comfort.cpp are reported apart:
+ *      there the firmware leaves NWS by design, by up to half of the step
+ *      between the two formulas (up to 1.3oC); the next line gives how
+ *      far the result went beyond that half step.
+ *      Prints the largest and mean absolute error with the worst input,
+ *      and the host time per reading of both versions.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Comfort.h"
+
+#define MAGNUS_E0           6.112
+#define MAGNUS_A            17.62
+#define MAGNUS_B            243.12
+
+/* Celsius saturates at 128oC; the NWS chart ends far below */
+#define HEAT_INDEX_MAX      100.0
+
+/* NWS switch to Rothfusz: mean of Steadman and T at 80oF. Comfort.cpp
+ * blends the two while Steadman + T is within HEAT_INDEX_BAND / 2 */
+#define HEAT_INDEX_SWITCH   ((2.0 * 80.0 - 64.0) / 1.8)
+#define HEAT_INDEX_BAND     1.0
+
+struct Error {
+    const char *name;
+    const char *unit;
+    double max;
+    double sum;
+    unsigned long count;
+    int max_t, max_h;
+};
+
+static double ref_dew_point(double t, double rh)
+{
+    double g = log(rh / 100.0) + MAGNUS_A * t / (MAGNUS_B + t);
+
+    return MAGNUS_B * g / (MAGNUS_A - g);
+}
+
+static double ref_absolute_humidity(double t, double rh)
+{
+    double e = rh / 100.0 * MAGNUS_E0 * exp(MAGNUS_A * t / (MAGNUS_B + t));
+
+    return 216.7 * e / (273.15 + t);
+}
+
+static double ref_steadman(double t, double rh)
+{
+    return 1.1 * t - 3.9444 + 0.026111 * rh;
+}
+
+/* NWS without the adjustments: Steadman, Rothfusz from the switch on */
+static double ref_rothfusz(double t, double rh)
+{
+    return -8.78469475556 + 1.61139411 * t + 2.33854883889 * rh
+        - 0.14611605 * t * rh - 0.012308094 * t * t
+        - 0.0164248277778 * rh * rh + 2.211732e-3 * t * t * rh
+        + 7.2546e-4 * t * rh * rh - 3.582e-6 * t * t * rh * rh;
+}
+
+/* NWS without the adjustments: Steadman, Rothfusz from the switch on */
+static double ref_heat_index(double t, double rh)
+{
+    double hi = ref_steadman(t, rh);
+
+    return hi + t < HEAT_INDEX_SWITCH ? hi : ref_rothfusz(t, rh);
+}
+
+static bool in_heat_index_band(double t, double rh)
+{
+    return fabs(ref_steadman(t, rh) + t - HEAT_INDEX_SWITCH) < HEAT_INDEX_BAND / 2;
+}
+
+static void add_error(Error *e, double value, double ref, int t, int h)
+{
+    double err = fabs(value - ref);
+
+    if (err > e->max) {
+        e->max = err;
+        e->max_t = t;
+        e->max_h = h;
+    }
+    e->sum += err;
+    e->count++;
+}
+
+static void print_error(const Error *e)
+{
+    printf("%-18s max %.3f %s at %.1foC %.1f%%, mean %.4f %s (%lu points)\n",
+           e->name, e->max, e->unit, e->max_t / 10.0, e->max_h / 10.0,
+           e->count ? e->sum / e->count : 0.0, e->unit, e->count);
+}
+
+static double now_ns()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static bool parse_range(const char *arg, int *min, int *max)
+{
+    double a, b;
+
+    if (sscanf(arg, "%lf:%lf", &a, &b) != 2 || a > b)
+        return false;
+
+    *min = (int)lround(a * 10);
+    *max = (int)lround(b * 10);
+
+    return true;
+}
+
+static int usage()
+{
+    fprintf(stderr, "usage: th-comfort-bench [-t min:max oC] [-h min:max %%RH]\n");
+
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    Error dew = { "dew point", "oC", 0, 0, 0, 0, 0 };
+    Error abs_humi = { "absolute humidity", "g/m3", 0, 0, 0, 0, 0 };
+    Error heat = { "heat index", "oC", 0, 0, 0, 0, 0 };
+    Error heat_band = { "  in blend band", "oC", 0, 0, 0, 0, 0 };
+    double band_excess = 0, value;
+    int t_min = -200, t_max = 600, h_min = 10, h_max = 1000;
+    int t, h, opt;
+    unsigned long calls = 0;
+    volatile double sink_d = 0;
+    volatile int32_t sink_q = 0;
+    double start, fixed_ns, double_ns, ref;
+
+    while ((opt = getopt(argc, argv, "t:h:")) != -1) {
+        switch (opt) {
+        case 't': if (!parse_range(optarg, &t_min, &t_max)) return usage(); break;
+        case 'h': if (!parse_range(optarg, &h_min, &h_max)) return usage(); break;
+        default: return usage();
+        }
+    }
+
+    for (t = t_min; t <= t_max; t++) {
+        for (h = h_min; h <= h_max; h++) {
+            Celsius temp = Celsius::from_scaled<10>(t);
+            Percent humi = Percent::from_scaled<10>(h);
+            double t_ref = temp.raw / 256.0;
+            double h_ref = humi.raw / 256.0;
+
+            add_error(&dew, Comfort::dew_point(temp, humi).raw / 256.0,
+                      ref_dew_point(t_ref, h_ref), t, h);
+            add_error(&abs_humi, Comfort::absolute_humidity(temp, humi).raw / 256.0,
+                      ref_absolute_humidity(t_ref, h_ref), t, h);
+            ref = ref_heat_index(t_ref, h_ref);
+            if (t < 260 || t > 500 || ref >= HEAT_INDEX_MAX)
+                continue;
+
+            value = Comfort::heat_index(temp, humi).raw / 256.0;
+            if (in_heat_index_band(t_ref, h_ref)) {
+                add_error(&heat_band, value, ref, t, h);
+                band_excess = fmax(band_excess, fabs(value - ref) -
+                    fabs(ref_rothfusz(t_ref, h_ref) - ref_steadman(t_ref, h_ref)) / 2);
+            }
+            else
+                add_error(&heat, value, ref, t, h);
+        }
+    }
+
+    print_error(&dew);
+    print_error(&abs_humi);
+    print_error(&heat);
+    print_error(&heat_band);
+    printf("    beyond half step max %.3f oC\n", band_excess);
+
+    /* Speed: the three quantities per reading */
+    start = now_ns();
+    for (t = t_min; t <= t_max; t++) {
+        for (h = h_min; h <= h_max; h++) {
+            Celsius temp = Celsius::from_scaled<10>(t);
+            Percent humi = Percent::from_scaled<10>(h);
+
+            sink_q = sink_q + Comfort::dew_point(temp, humi).raw +
+                     Comfort::absolute_humidity(temp, humi).raw +
+                     Comfort::heat_index(temp, humi).raw;
+            calls++;
+        }
+    }
+    fixed_ns = (now_ns() - start) / calls;
+
+    start = now_ns();
+    for (t = t_min; t <= t_max; t++)
+        for (h = h_min; h <= h_max; h++)
+            sink_d = sink_d + ref_dew_point(t / 10.0, h / 10.0) +
+                     ref_absolute_humidity(t / 10.0, h / 10.0) +
+                     ref_heat_index(t / 10.0, h / 10.0);
+    double_ns = (now_ns() - start) / calls;
+
+    printf("host time         fixed %.1f ns, double %.1f ns per reading (3 quantities)\n",
+           fixed_ns, double_ns);
+
+    return 0;
+}
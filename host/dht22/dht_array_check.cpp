@@ -0,0 +1,161 @@
+/*
+ * dht_array_check.cpp : Dht22Array against one DHT22 model per lane
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      g++ -std=c++14 -O2 -D__MSP430G2553__ -I host -I CPP \
+ *          -o th-dht-array-check host/dht22/dht_array_check.cpp \
+ *          host/Dht22Model.cpp host/msp430_host.cpp
+ *
+ *      th-dht-array-check [-n reads] [-s] [-r seed]
+ *
+ *      Eight Dht22Model sensors on P2.0 to P2.7 read by one
+ *      Dht22Array<Pin<Port2, 0xFF>> n times, 2s apart in virtual time.
+ *      The lanes disagree: each sensor gets its own ambient on every read
+ *      (-40 to 80oC, so both signs, and 0 to 100 %RH), and with -s its
+ *      own pulse widths in the datasheet range, so the lanes drift apart
+ *      within a frame. On every read one lane may be missing and another
+ *      may send a bad checksum.
+ *
+ *      Each read checks the valid mask against the lanes that sent a
+ *      good frame, and the humidity and signed temperature of every
+ *      valid lane against the frame its model sent. Prints each failure
+ *      and exits with 1 if any.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <random>
+
+#include <msp430.h>
+
+#include "Dht22Array.h"
+#include "Dht22Model.h"
+
+#define CHECK_LANES             8
+#define CHECK_READ_PERIOD_US    2000000ULL
+#define CHECK_MCLK_HZ           16000000ULL
+
+/* Per read: chance of a missing lane and of a lane with a bad checksum */
+#define CHECK_MISSING_RATE      0.1
+#define CHECK_CORRUPT_RATE      0.1
+
+typedef Pin<Port2, 0xFF> ZonePins;
+
+static Dht22Model *models[CHECK_LANES];
+static unsigned long checks, failures;
+
+static void port_hook(host_mcu_t *mcu, uint8_t port)
+{
+    uint8_t i;
+
+    for (i=0; i < CHECK_LANES; i++)
+        models[i]->update(mcu, port);
+}
+
+static void check(bool cond, unsigned read, uint8_t lane, const char *what,
+                  long value, long expected)
+{
+    checks++;
+    if (cond)
+        return;
+
+    failures++;
+    if (failures <= 20)
+        printf("read %u lane %u: %s %ld, expected %ld\n", read, lane, what, value, expected);
+}
+
+static int usage()
+{
+    fprintf(stderr, "usage: th-dht-array-check [-n reads] [-s] [-r seed]\n"
+                    "  -n  reads (default 2000)\n"
+                    "  -s  pulse widths drawn in the datasheet range per lane and read\n"
+                    "  -r  random seed (default 1)\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    host_mcu_t mcu;
+    Dht22Array<ZonePins> zones;
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    unsigned reads = 2000, n;
+    uint32_t seed = 1;
+    bool spread = false;
+    uint8_t i, valid, expected, missing, corrupt;
+    int16_t temp;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:sr:")) != -1) {
+        switch (opt) {
+        case 'n': reads = atoi(optarg); break;
+        case 's': spread = true; break;
+        case 'r': seed = strtoul(optarg, NULL, 0); break;
+        default: return usage();
+        }
+    }
+    if (!reads)
+        return usage();
+
+    rng.seed(seed);
+    for (i=0; i < CHECK_LANES; i++) {
+        models[i] = new Dht22Model(2, 1 << i);
+        models[i]->seed(seed + 1 + i);
+        models[i]->timing_spread = spread;
+    }
+
+    memset(&mcu, 0, sizeof(mcu));
+    mcu.port_hook = port_hook;
+    mcu.sr = GIE;
+    host_mcu = &mcu;
+
+    /* Lines idle high */
+    ZonePins::input();
+
+    for (n=0; n < reads; n++) {
+        missing = (uint8_t)(uniform(rng) < CHECK_MISSING_RATE ? 1 << (rng() % CHECK_LANES) : 0);
+        corrupt = (uint8_t)(uniform(rng) < CHECK_CORRUPT_RATE ? 1 << (rng() % CHECK_LANES) : 0);
+
+        for (i=0; i < CHECK_LANES; i++) {
+            models[i]->temperature = -40.0 + uniform(rng) * 120.0;
+            models[i]->humidity = uniform(rng) * 100.0;
+            models[i]->missing = missing & (1 << i);
+            models[i]->checksum_error_rate = corrupt & (1 << i) ? 1.0 : 0.0;
+        }
+
+        mcu.cycles += CHECK_READ_PERIOD_US * (CHECK_MCLK_HZ / 1000000);
+        valid = zones.dht_response();
+
+        check(mcu.sr & GIE, n, 0, "GIE after the read", 0, GIE);
+
+        expected = (uint8_t)~(missing | corrupt);
+        check(valid == expected, n, 0, "valid mask", valid, expected);
+
+        for (i=0; i < CHECK_LANES; i++) {
+            const uint8_t *sent = models[i]->sent;
+
+            if (!(valid & expected & (1 << i)))
+                continue;
+
+            temp = (int16_t)((sent[2] & 0x7F) << 8 | sent[3]);
+            if (sent[2] & 0x80)
+                temp = -temp;
+
+            check(zones.get_humid(i) == (sent[0] << 8 | sent[1]), n, i, "humidity",
+                  zones.get_humid(i), sent[0] << 8 | sent[1]);
+            check(zones.get_temp(i) == temp, n, i, "temperature", zones.get_temp(i), temp);
+        }
+    }
+
+    printf("%u reads of %u lanes, %lu checks, %lu failures\n", reads, CHECK_LANES, checks, failures);
+
+    for (i=0; i < CHECK_LANES; i++)
+        delete models[i];
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,196 @@
+/*
+ * dht_bench.cpp : DHT22 decoder robustness and active time on the waveform model
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      g++ -std=c++14 -O2 -D__MSP430G2553__ -I host -I CPP -o th-dht-bench \
+ *          host/dht22/dht_bench.cpp host/Dht22Model.cpp host/msp430_host.cpp
+ *
+ *      th-dht-bench [-n reads] [-s] [-j jitter us] [-g glitch rate]
+ *                   [-w glitch us] [-c checksum error rate] [-m missing rate]
+ *                   [-r seed]
+ *
+ *      Runs Dht22<Pin<Port2, BIT0>>::dht_response() of the firmware n times
+ *      against Dht22Model with the faults given, 2s apart in virtual time,
+ *      and sorts the results:
+ *
+ *          ok          checksum valid, values equal to the model ambient
+ *          wrong       checksum valid, wrong values: undetected error
+ *          checksum    checksum error reported
+ *          timeout     edge lost or extra inside the frame
+ *          no response reset_1w() failed
+ *          hang        still polling the pin 20ms after the start signal
+ *
+ *      A hang is detected in the port hook and ends the read with an
+ *      exception. Active time per read is the virtual time from the call
+ *      to its return at 16MHz, the CPU being awake for all of it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <random>
+
+#include <msp430.h>
+
+#include "Dht22.h"
+#include "Dht22Model.h"
+
+#define BENCH_MCLK_HZ           16000000ULL
+#define BENCH_READ_PERIOD_US    2000000ULL
+#define BENCH_HANG_US           20000ULL
+
+typedef Pin<Port2, BIT0> DhtPin;
+
+enum {
+    RESULT_OK,
+    RESULT_WRONG,
+    RESULT_CHECKSUM,
+    RESULT_TIMEOUT,
+    RESULT_NO_RESPONSE,
+    RESULT_HANG,
+    RESULTS
+};
+
+static const char *result_names[RESULTS] = {
+    "ok", "wrong", "checksum", "timeout", "no response", "hang"
+};
+
+struct Bench {
+    Dht22Model *model;
+    uint64_t deadline;
+};
+
+struct Hang {};
+
+static void port_hook(host_mcu_t *mcu, uint8_t port)
+{
+    Bench *bench = (Bench *)mcu->user;
+
+    bench->model->update(mcu, port);
+
+    if (mcu->cycles > bench->deadline)
+        throw Hang();
+}
+
+static int usage()
+{
+    fprintf(stderr, "usage: th-dht-bench [-n reads] [-s] [-j jitter us] [-g glitch rate] [-w glitch us]\n"
+                    "                    [-c checksum error rate] [-m missing rate] [-r seed]\n"
+                    "  -n  reads (default 10000)\n"
+                    "  -s  pulse widths drawn in the datasheet range on each read\n"
+                    "  -j  gaussian jitter of every pulse, us (default 0)\n"
+                    "  -g  probability of a glitch per bit (default 0)\n"
+                    "  -w  glitch width, us (default 2)\n"
+                    "  -c  probability of a corrupted checksum per read (default 0)\n"
+                    "  -m  probability of a missing sensor per read (default 0)\n"
+                    "  -r  random seed (default 1)\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    host_mcu_t mcu;
+    Dht22Model model(2, BIT0);
+    Dht22<DhtPin> dht;
+    Bench bench;
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    unsigned reads = 10000, n;
+    double missing_rate = 0;
+    uint32_t seed = 1;
+    uint64_t count[RESULTS] = { 0 };
+    uint64_t start, cycles, total = 0, min = UINT64_MAX, max = 0;
+    uint8_t ret;
+    int opt, result;
+
+    while ((opt = getopt(argc, argv, "n:sj:g:w:c:m:r:")) != -1) {
+        switch (opt) {
+        case 'n': reads = atoi(optarg); break;
+        case 's': model.timing_spread = true; break;
+        case 'j': model.jitter_us = atof(optarg); break;
+        case 'g': model.glitch_rate = atof(optarg); break;
+        case 'w': model.glitch_us = atof(optarg); break;
+        case 'c': model.checksum_error_rate = atof(optarg); break;
+        case 'm': missing_rate = atof(optarg); break;
+        case 'r': seed = strtoul(optarg, NULL, 0); break;
+        default: return usage();
+        }
+    }
+    if (!reads)
+        return usage();
+
+    memset(&mcu, 0, sizeof(mcu));
+    mcu.port_hook = port_hook;
+    mcu.user = &bench;
+    host_mcu = &mcu;
+
+    bench.model = &model;
+    bench.deadline = UINT64_MAX;
+    model.seed(seed);
+    rng.seed(seed + 1);
+
+    /* Line idles high */
+    DhtPin::input();
+
+    for (n=0; n < reads; n++) {
+        model.temperature = -40.0 + uniform(rng) * 120.0;
+        model.humidity = uniform(rng) * 100.0;
+        model.missing = missing_rate > 0 && uniform(rng) < missing_rate;
+
+        mcu.cycles += BENCH_READ_PERIOD_US * (BENCH_MCLK_HZ / 1000000);
+        start = mcu.cycles;
+        bench.deadline = start + BENCH_HANG_US * (BENCH_MCLK_HZ / 1000000);
+
+        try {
+            ret = dht.dht_response();
+
+            if (ret == DHT22_NO_RESPONSE || ret == DHT22_NO_RELEASE)
+                result = RESULT_NO_RESPONSE;
+            else if (ret == DHT22_TIMEOUT)
+                result = RESULT_TIMEOUT;
+            else if (ret == DHT22_CHECKSUM)
+                result = RESULT_CHECKSUM;
+            else if (dht.get_humid() == (model.sent[0] << 8 | model.sent[1]) &&
+                     dht.get_temp() == (model.sent[2] & 0x80 ? -1 : 1) *
+                                       ((model.sent[2] & 0x7F) << 8 | model.sent[3]))
+                result = RESULT_OK;
+            else
+                result = RESULT_WRONG;
+        }
+        catch (Hang &) {
+            result = RESULT_HANG;
+        }
+
+        /* Line released after a hang */
+        bench.deadline = UINT64_MAX;
+        DhtPin::input();
+
+        cycles = mcu.cycles - start;
+        count[result]++;
+        total += cycles;
+        if (cycles < min)
+            min = cycles;
+        if (cycles > max)
+            max = cycles;
+    }
+
+    printf("reads             %u\n", reads);
+    printf("faults            spread %s, jitter %.1f us, glitch %.4f/bit of %.1f us, "
+           "checksum %.4f, missing %.4f\n", model.timing_spread ? "on" : "off", model.jitter_us,
+           model.glitch_rate, model.glitch_us, model.checksum_error_rate, missing_rate);
+    printf("injected          %u glitches, %u bad checksums\n", model.glitches, model.corrupted);
+
+    for (n=0; n < RESULTS; n++)
+        printf("%-17s %llu (%.3f %%)\n", result_names[n], (unsigned long long)count[n],
+               100.0 * count[n] / reads);
+
+    printf("active time/read  mean %.1f us, min %.1f us, max %.1f us\n",
+           (double)total / reads * 1e6 / BENCH_MCLK_HZ, min * 1e6 / BENCH_MCLK_HZ,
+           max * 1e6 / BENCH_MCLK_HZ);
+
+    return 0;
+}
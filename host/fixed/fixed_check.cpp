@@ -0,0 +1,255 @@
+/*
+ * fixed_check.cpp : checks of lib/fixed.h and lib/format.c against double
+ *                   precision and plain division
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      g++ -std=c++14 -O2 -I CPP -o th-fixed-check \
+ *          host/fixed/fixed_check.cpp -x c CPP/lib/format.c
+ *
+ *      th-fixed-check
+ *
+ *      Saturation of from_int(), the operators and convert() at both
+ *      limits of int16_t and uint16_t; constant<> against NUM / DEN
+ *      rounded half away from zero; from_scaled<> over every int16_t
+ *      input against value / DEN rounded half up and saturated; to_scaled
+ *      over every raw value against round half up; format_digits() and
+ *      to_digits() against the division and modulo version for every
+ *      uint16_t value and digit count, format_digits_signed() for every
+ *      int16_t. Prints each failure and exits with 1 if any.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include <lib/fixed.h>
+#include <lib/format.h>
+
+static unsigned long checks, failures;
+
+#define CHECK(cond, ...) do {                       \
+        checks++;                                   \
+        if (!(cond)) {                              \
+            failures++;                             \
+            if (failures <= 20) {                   \
+                printf("%s:%d: ", __FILE__, __LINE__); \
+                printf(__VA_ARGS__);                \
+                printf("\n");                       \
+            }                                       \
+        }                                           \
+    } while (0)
+
+typedef Fixed<8> Q8;
+typedef Fixed<12, uint16_t> UQ12;
+
+static void check_saturation()
+{
+    /* from_int(): 200 << 8 and 300 << 12 do not fit */
+    CHECK(Q8::from_int(200).raw == INT16_MAX, "Q8 from_int(200) = %d", Q8::from_int(200).raw);
+    CHECK(Q8::from_int(-200).raw == INT16_MIN, "Q8 from_int(-200) = %d", Q8::from_int(-200).raw);
+    CHECK(Q8::from_int(-128).raw == INT16_MIN, "Q8 from_int(-128) = %d", Q8::from_int(-128).raw);
+    CHECK(Q8::from_int(127).raw == 127 * 256, "Q8 from_int(127) = %d", Q8::from_int(127).raw);
+    CHECK(UQ12::from_int(300).raw == UINT16_MAX, "UQ12 from_int(300) = %u", UQ12::from_int(300).raw);
+    CHECK(UQ12::from_int(-1).raw == 0, "UQ12 from_int(-1) = %u", UQ12::from_int(-1).raw);
+    CHECK(UQ12::from_int(15).raw == 15 * 4096, "UQ12 from_int(15) = %u", UQ12::from_int(15).raw);
+
+    /* Sum and difference */
+    Q8 max = Q8::from_raw(INT16_MAX), min = Q8::from_raw(INT16_MIN), one = Q8::from_int(1);
+
+    CHECK((max + one).raw == INT16_MAX, "Q8 max + 1 = %d", (max + one).raw);
+    CHECK((min - one).raw == INT16_MIN, "Q8 min - 1 = %d", (min - one).raw);
+    CHECK((min + min).raw == INT16_MIN, "Q8 min + min = %d", (min + min).raw);
+    CHECK((max - min).raw == INT16_MAX, "Q8 max - min = %d", (max - min).raw);
+    CHECK((min - max).raw == INT16_MIN, "Q8 min - max = %d", (min - max).raw);
+    CHECK((max - one).raw == INT16_MAX - 256, "Q8 max - 1 = %d", (max - one).raw);
+
+    UQ12 umax = UQ12::from_raw(UINT16_MAX), uzero = UQ12::from_raw(0), uone = UQ12::from_int(1);
+
+    CHECK((umax + uone).raw == UINT16_MAX, "UQ12 max + 1 = %u", (umax + uone).raw);
+    CHECK((umax + umax).raw == UINT16_MAX, "UQ12 max + max = %u", (umax + umax).raw);
+    CHECK((uzero - uone).raw == 0, "UQ12 0 - 1 = %u", (uzero - uone).raw);
+    CHECK((uone - umax).raw == 0, "UQ12 1 - max = %u", (uone - umax).raw);
+    CHECK((umax - uone).raw == UINT16_MAX - 4096, "UQ12 max - 1 = %u", (umax - uone).raw);
+
+    /* Products: 127.9 * 127.9 and 127.9 * -128 */
+    CHECK((max * max).raw == INT16_MAX, "Q8 max * max = %d", (max * max).raw);
+    CHECK((max * min).raw == INT16_MIN, "Q8 max * min = %d", (max * min).raw);
+    CHECK((min * min).raw == INT16_MAX, "Q8 min * min = %d", (min * min).raw);
+    CHECK((min * one).raw == INT16_MIN, "Q8 min * 1 = %d", (min * one).raw);
+    CHECK((umax * umax).raw == UINT16_MAX, "UQ12 max * max = %u", (umax * umax).raw);
+    CHECK((umax * uone).raw == UINT16_MAX, "UQ12 max * 1 = %u", (umax * uone).raw);
+    CHECK((umax * uzero).raw == 0, "UQ12 max * 0 = %u", (umax * uzero).raw);
+
+    /* convert(): more fraction bits, signed to unsigned */
+    Fixed<12> c1 = Fixed<4>::from_int(100).convert<12, int16_t>();
+    Fixed<12> c2 = Fixed<4>::from_int(-100).convert<12, int16_t>();
+    UQ12 c3 = Q8::from_int(-1).convert<12, uint16_t>();
+    UQ12 c4 = Q8::from_int(100).convert<12, uint16_t>();
+    Q8 c5 = UQ12::from_raw(UINT16_MAX).convert<8, int16_t>();
+
+    CHECK(c1.raw == INT16_MAX, "Q4 100 -> Q12 = %d", c1.raw);
+    CHECK(c2.raw == INT16_MIN, "Q4 -100 -> Q12 = %d", c2.raw);
+    CHECK(c3.raw == 0, "Q8 -1 -> UQ12 = %u", c3.raw);
+    CHECK(c4.raw == UINT16_MAX, "Q8 100 -> UQ12 = %u", c4.raw);
+    CHECK(c5.raw == UINT16_MAX >> 4, "UQ12 max -> Q8 = %d", c5.raw);
+}
+
+/* NUM / DEN * 2^FRAC rounded half away from zero */
+template <uint8_t FRAC, class T, int32_t NUM, int32_t DEN>
+static void check_constant()
+{
+    long expected = lround((double)NUM * ((int32_t)1 << FRAC) / DEN);
+    T raw = Fixed<FRAC, T>::template constant<NUM, DEN>().raw;
+
+    CHECK(raw == expected, "constant<%d, %d>() Q%u = %ld, expected %ld",
+          (int)NUM, (int)DEN, FRAC, (long)raw, expected);
+}
+
+static void check_constants()
+{
+    check_constant<8, int16_t, 235, 10>();
+    check_constant<8, int16_t, -235, 10>();
+    check_constant<8, int16_t, -3, 2>();
+    check_constant<8, int16_t, 1, 3>();
+    check_constant<8, int16_t, -1, 3>();
+    check_constant<8, int16_t, 2, 3>();
+    check_constant<8, int16_t, -2, 3>();
+    /* Exact halves: 1/512 and -1/512 in Q8 */
+    check_constant<8, int16_t, 1, 512>();
+    check_constant<8, int16_t, -1, 512>();
+    check_constant<8, int16_t, 3, 512>();
+    check_constant<8, int16_t, -3, 512>();
+    check_constant<8, int16_t, 1, 1024>();
+    check_constant<8, int16_t, 127, 1>();
+    check_constant<8, int16_t, -128, 1>();
+    check_constant<15, int16_t, 1, 3>();
+    check_constant<15, int16_t, -1, 1>();
+    check_constant<15, int16_t, 9999, 10000>();
+    check_constant<0, int16_t, 5, 2>();
+    check_constant<0, int16_t, -5, 2>();
+    check_constant<0, int16_t, 32767, 1>();
+    check_constant<12, uint16_t, 33, 10>();
+    check_constant<12, uint16_t, 1, 8192>();
+    check_constant<12, uint16_t, 15, 1>();
+    check_constant<12, uint16_t, 1, 7>();
+    check_constant<15, uint16_t, 1, 1>();
+    check_constant<10, uint16_t, 63, 1>();
+}
+
+/* Every int16_t input: floor(value / DEN + 0.5), saturated */
+template <uint8_t FRAC, class T, uint32_t DEN>
+static void check_from_scaled()
+{
+    int64_t lo = (T)-1 < 0 ? INT16_MIN : 0;
+    int64_t hi = (T)-1 < 0 ? INT16_MAX : UINT16_MAX;
+    int64_t num, expected;
+    int32_t v;
+
+    for (v = INT16_MIN; v <= INT16_MAX; v++) {
+        T raw = Fixed<FRAC, T>::template from_scaled<DEN>((int16_t)v).raw;
+
+        /* Floor division of (2 v 2^FRAC + DEN) / 2 DEN */
+        num = 2 * (int64_t)v * ((int64_t)1 << FRAC) + DEN;
+        expected = num >= 0 ? num / (2 * DEN) : -((-num + 2 * DEN - 1) / (2 * DEN));
+        if (expected > hi)
+            expected = hi;
+        if (expected < lo)
+            expected = lo;
+
+        CHECK(raw == expected, "from_scaled<%u>(%d) Q%u = %ld, expected %lld",
+              DEN, v, FRAC, (long)raw, (long long)expected);
+    }
+}
+
+/* Every raw value: floor(value * SCALE + 0.5) */
+template <uint8_t FRAC, class T, uint16_t SCALE>
+static void check_to_scaled()
+{
+    int32_t lo = (T)-1 < 0 ? INT16_MIN : 0;
+    int32_t hi = (T)-1 < 0 ? INT16_MAX : UINT16_MAX;
+    int32_t r;
+
+    for (r = lo; r <= hi; r++) {
+        Fixed<FRAC, T> f = Fixed<FRAC, T>::from_raw((T)r);
+        double expected = floor((double)r * SCALE / ((int32_t)1 << FRAC) + 0.5);
+        long got = (long)f.template to_scaled<SCALE>();
+
+        CHECK(got == (long)expected, "to_scaled<%u>() Q%u raw %d = %ld, expected %.0f",
+              SCALE, FRAC, r, got, expected);
+    }
+}
+
+/* Lowest count digits by division and modulo */
+static void ref_digits(uint32_t value, uint8_t *digits, uint8_t count)
+{
+    while (count--) {
+        digits[count] = value % 10;
+        value /= 10;
+    }
+}
+
+static void check_digits()
+{
+    uint8_t digits[7], ref[7];
+    uint32_t v;
+    int32_t s;
+    uint8_t count, i, negative;
+
+    for (v = 0; v <= UINT16_MAX; v++) {
+        for (count = 1; count <= 7; count++) {
+            format_digits((uint16_t)v, digits, count);
+            ref_digits(v, ref, count);
+            for (i = 0; i < count; i++)
+                CHECK(digits[i] == ref[i], "format_digits(%u, %u) digit %u = %u, expected %u",
+                      v, count, i, digits[i], ref[i]);
+        }
+    }
+
+    for (s = INT16_MIN; s <= INT16_MAX; s++) {
+        negative = format_digits_signed((int16_t)s, digits, 5);
+        ref_digits(s < 0 ? -s : s, ref, 5);
+        CHECK(negative == (s < 0), "format_digits_signed(%d) sign %u", s, negative);
+        for (i = 0; i < 5; i++)
+            CHECK(digits[i] == ref[i], "format_digits_signed(%d) digit %u = %u, expected %u",
+                  s, i, digits[i], ref[i]);
+    }
+
+    /* to_digits(): tenths of every UQ12 value, 3 digits as on the display */
+    for (v = 0; v <= UINT16_MAX; v++) {
+        UQ12::from_raw((uint16_t)v).to_digits<10>(digits, 3);
+        ref_digits((uint16_t)UQ12::from_raw((uint16_t)v).to_scaled<10>(), ref, 3);
+        for (i = 0; i < 3; i++)
+            CHECK(digits[i] == ref[i], "UQ12 raw %u to_digits<10> digit %u = %u, expected %u",
+                  v, i, digits[i], ref[i]);
+    }
+}
+
+int main()
+{
+    check_saturation();
+    check_constants();
+
+    check_from_scaled<8, int16_t, 10>();
+    check_from_scaled<8, int16_t, 100>();
+    check_from_scaled<12, int16_t, 10>();
+    check_from_scaled<4, int16_t, 3>();
+    check_from_scaled<15, int16_t, 1000>();
+    check_from_scaled<12, uint16_t, 1000>();
+    check_from_scaled<10, uint16_t, 10>();
+    check_from_scaled<0, int16_t, 7>();
+    check_from_scaled<15, uint16_t, 3>();
+
+    check_to_scaled<8, int16_t, 10>();
+    check_to_scaled<8, int16_t, 1>();
+    check_to_scaled<12, uint16_t, 1000>();
+    check_to_scaled<10, uint16_t, 10>();
+    check_to_scaled<15, int16_t, 100>();
+
+    check_digits();
+
+    printf("%lu checks, %lu failures\n", checks, failures);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,776 @@
+/*
+ * fleet.cpp : runs many host-built firmware instances in virtual time
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      g++ -std=c++14 -O2 -pthread -D__MSP430G2553__ -I host -I CPP \
+ *          -o th-fleet host/fleet/fleet.cpp host/Dht22Model.cpp \
+ *          host/Ssd1306Model.cpp host/msp430_host.cpp host/i2c_host.cpp \
+ *          host/uart_host.cpp host/timer_delay_host.cpp \
+ *          host/rs485_host.cpp host/node_config_host.cpp \
+ *          CPP/ThermoHygrometer.cpp CPP/SSD1306.cpp CPP/MainScreen.cpp \
+ *          host/clock_host.cpp CPP/Telemetry.cpp CPP/BusNode.cpp \
+ *          CPP/AdaptiveRate.cpp CPP/LagEstimator.cpp CPP/Comfort.cpp \
+ *          CPP/SelfHeating.cpp CPP/lib/adc10.c \
+ *          -x c CPP/lib/telemetry_frame.c CPP/lib/crc.c CPP/lib/format.c
+ *
+ *      lib/adc10.c drives the ADC10 registers of the mock, which is C++:
+ *      it is built as C++, ahead of -x c. It is empty on the F247, whose
+ *      nodes read neither the battery nor the die temperature.
+ *
+ *      Add -DTELEMETRY_RS485 to build the polled bus variant (th-fleet-bus),
+ *      -DAPP_IDLE_MHZ=16 to keep MCLK at 16MHz between measurements and
+ *      -DSENSOR_POWER_GATED for a DHT22 switched by P2.1 instead of on
+ *      VCC. The dual-panel unit is -D__MSP430F247__
+ *      -DOLED_SECOND_I2C_ADDRESS=0x3D: a second SSD1306 model is attached
+ *      at that address.
+ *
+ *      th-fleet [-n nodes] [-j threads] [-t seconds] [-s speed] [-e epoch ms]
+ *               [-o output]
+ *
+ *      Each node is one ThermoHygrometer instance with its own register
+ *      context, a DHT22 waveform model on P2.0, an SSD1306 model on the
+ *      I2C bus, and a battery voltage and a die temperature on the ADC.
+ *      The DHT22 reads the air temperature plus the warming of its board:
+ *      the OLED while lit and the rest of the board since power-up, each a
+ *      first order lag, with a spread of +-25% between nodes around the
+ *      constants of SelfHeating.h. Its watchdog interval
+ *      runs from a VLO picked between 10 and 14kHz, so nodes drift apart
+ *      like real ones. Node n gets address n + 1 in information memory.
+ *
+ *      Virtual time advances in epochs. In each epoch the worker threads
+ *      run every node due in it: Update(), then sleep until an interval
+ *      of the watchdog wakes it again. Telemetry frames of the epoch are
+ *      then written to the output (file, FIFO, tty or the pty of
+ *      th-gateway ingest --pty). With a speed factor the epochs are paced
+ *      against the wall clock, otherwise they run as fast as the host
+ *      allows.
+ *
+ *      The bus variant opens the output read/write as a shared RS-485
+ *      line: bytes received during an epoch are delivered to the RX IRQ of
+ *      every node at the start of the next one, and the replies go back
+ *      on the line. It runs in real time with 5ms epochs unless -s/-e
+ *      are given; poll it with th-collector.
+ *
+ *      The report gives the host CPU time spent in the firmware per
+ *      wake-up and the virtual active time (cycles spent awake) per
+ *      wake-up, which is the duty cycle of the real node, and the time from
+ *      power-up to the first reading on the display. Time awake and
+ *      asleep is also split by MCLK and low power mode, and weighted by
+ *      the supply currents below into an average current per node. The
+ *      DHT22 standby current is given apart, for the time it is powered.
+ *      The temperature of the sample frames is compared with the air
+ *      temperature and so is the raw DHT22 reading.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <msp430.h>
+
+#include <lib/node_config.h>
+#include <lib/rs485.h>
+#include <lib/telemetry_frame.h>
+
+#include "ThermoHygrometer.h"
+#include "Dht22Model.h"
+#include "Ssd1306Model.h"
+
+#define FLEET_MCLK_HZ           16000000ULL
+
+#ifdef TELEMETRY_RS485
+#define FLEET_EPOCH_MS          5
+#define FLEET_SPEED             1.0
+#else
+#define FLEET_EPOCH_MS          1000
+#define FLEET_SPEED             0.0
+#endif
+
+/* WDT_ADLY_1000: ACLK / 32768 */
+#define FLEET_WDT_DIVIDER       32768ULL
+#define FLEET_VLO_MIN_HZ        10000
+#define FLEET_VLO_MAX_HZ        14000
+
+/* ADC10: 16 sample + 13 conversion clocks of the ~5MHz ADC10OSC; die
+ * temperature: 64 + 13 clocks of ADC10OSC / 4 */
+#define FLEET_ADC_CYCLES        93
+#define FLEET_ADC_TEMP_CYCLES   986
+/* Conversion noise, LSB rms */
+#define FLEET_ADC_NOISE_LSB     0.5
+
+/* Board warming (SelfHeating.h): DHT22 rise with the OLED lit, oC, and
+ * its time constant; warming of the board at the die and the share of
+ * it at the DHT22 */
+#define FLEET_OLED_RISE         0.8
+#define FLEET_OLED_TAU_S        240.0
+#define FLEET_BOARD_RISE        1.5
+#define FLEET_BOARD_TAU_S       600.0
+#define FLEET_BOARD_SHARE       0.3
+#define FLEET_HEAT_SPREAD       0.25
+
+/* Ambient random walk: one step of 0.05oC / 0.2%RH per this many
+ * seconds, independent of how often the node samples */
+#define FLEET_ENV_STEP_S        27.0
+
+/* Nodes taken by a worker at a time */
+#define FLEET_CHUNK             16
+
+/* Supply current estimate (uA): approximate G2x53 typicals at 3V. Awake
+ * includes the I2C and UART waits the firmware spends in LPM0 */
+struct FleetCurrent {
+    uint8_t mhz;
+    double awake_ua;
+    double lpm0_ua;
+};
+
+static const FleetCurrent fleet_currents[] = {
+    { 1, 300, 60 },
+    { 8, 2200, 240 },
+    { 12, 3200, 330 },
+    { 16, 4200, 420 },
+};
+
+#define FLEET_LPM3_UA           0.5
+
+/* DHT22 while powered and idle: datasheet standby current */
+#define FLEET_DHT22_UA          50.0
+
+struct Node {
+    host_mcu_t mcu;
+    Dht22Model dht;
+    Ssd1306Model oled;
+#ifdef OLED_SECOND_I2C_ADDRESS
+    Ssd1306Model oled2;
+#endif
+    std::unique_ptr<ThermoHygrometer> app;
+    std::mt19937 rng;
+
+    uint64_t power_up;
+    uint64_t wdt_period;
+    uint64_t next_wdt;
+    bool started;
+    bool awake;
+    /* Low power mode of the current sleep (ThermoHygrometer::sleep_bits) */
+    uint16_t sleep_sr;
+
+    /* Environment */
+    double air_temperature;
+    double base_temperature;
+    double base_humidity;
+    double battery_mv;
+    /* Board warming: OLED (0 to 1) and die (oC), constants of the node */
+    double oled_heat;
+    double board_heat;
+    double oled_rise;
+    double board_rise;
+    double board_share;
+    /* Counter value of the last update_environment() */
+    uint64_t env_cycles;
+
+    /* Frames of the current epoch */
+    std::vector<uint8_t> *tx;
+
+    /* Statistics */
+    uint64_t wakes;
+    uint64_t sleep_cycles;
+    uint64_t cpu_ns;
+    uint64_t frames;
+    /* Sample frames: sum of |temperature - air| reported and raw, oC */
+    uint64_t temp_count;
+    double temp_error;
+    double raw_error;
+    /* Power-up to the end of the wake-up showing the first reading */
+    uint64_t first_reading;
+    /* Time asleep at each MCLK (MHz index) */
+    uint64_t lpm0_cycles[HOST_MCLK_MHZ + 1];
+    uint64_t lpm3_cycles[HOST_MCLK_MHZ + 1];
+
+    Node() : mcu(), dht(2, BIT0), oled(OLED_I2C_ADDRESS)
+#ifdef OLED_SECOND_I2C_ADDRESS
+           , oled2(OLED_SECOND_I2C_ADDRESS)
+#endif
+    {
+#ifdef SENSOR_POWER_GATED
+        /* DhtPowerPin */
+        dht.power_pin(2, BIT1);
+#endif
+    }
+};
+
+struct Worker {
+    std::thread thread;
+    std::vector<uint8_t> tx;
+    uint64_t cpu_ns;
+};
+
+static std::vector<std::unique_ptr<Node>> nodes;
+static std::vector<std::unique_ptr<Worker>> workers;
+
+/* Epoch handshake between the main thread and the workers */
+static std::mutex lock;
+static std::condition_variable start_cv, done_cv;
+static uint64_t generation;
+static uint64_t epoch_end;
+static unsigned busy;
+static bool quit;
+static std::atomic<size_t> next_node;
+
+static uint64_t thread_cpu_ns()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t wall_ns()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* CPU off for cycles in the low power mode of sr */
+static void add_sleep(Node *node, uint16_t sr, uint64_t cycles)
+{
+    uint8_t mhz = node->mcu.mclk_mhz ? node->mcu.mclk_mhz : HOST_MCLK_MHZ;
+
+    node->sleep_cycles += cycles;
+    if (sr & SCG1)
+        node->lpm3_cycles[mhz] += cycles;
+    else
+        node->lpm0_cycles[mhz] += cycles;
+}
+
+static void port_hook(host_mcu_t *mcu, uint8_t port)
+{
+    Node *node = (Node *)mcu->user;
+
+    node->dht.update(mcu, port);
+}
+
+#ifdef BOARD_ADC10
+/* lib/adc10.c, built as C++ */
+void ADC10_ISR(void);
+#endif
+
+/**
+ * @brief  CPU off inside the firmware (ADC conversion, power-up wait):
+ *         finish the pending ADC conversion or run the watchdog interval,
+ *         as the ISRs would. Intervals that expired while the CPU was
+ *         awake run without waking it: their wake-up is lost as on the
+ *         device.
+ */
+static void sleep_hook(host_mcu_t *mcu)
+{
+    Node *node = (Node *)mcu->user;
+    uint64_t now = mcu->cycles;
+    bool overdue;
+
+#ifdef BOARD_ADC10
+    if (mcu->adc10ctl0 & ADC10SC) {
+        mcu->adc10ctl0 &= ~ADC10SC;
+        if ((mcu->adc10ctl1 & 0xF000) == INCH_10) {
+            /* Line through the calibration points of the TLV */
+            std::normal_distribution<double> noise(0.0, FLEET_ADC_NOISE_LSB);
+
+            mcu->cycles += FLEET_ADC_TEMP_CYCLES;
+            mcu->adc10mem = (uint16_t)lround(ADC10_CAL_15T30 + (node->air_temperature +
+                                             node->board_heat - 30.0) *
+                                             (ADC10_CAL_15T85 - ADC10_CAL_15T30) / 55.0 +
+                                             noise(node->rng));
+        }
+        else {
+            mcu->cycles += FLEET_ADC_CYCLES;
+            mcu->adc10mem = (uint16_t)(node->battery_mv * 1024 / 3300);
+        }
+        if (mcu->adc10mem > 1023)
+            mcu->adc10mem = 1023;
+        ADC10_ISR();
+        return;
+    }
+#endif
+
+    overdue = node->next_wdt < now;
+    if (!overdue) {
+        add_sleep(node, mcu->sr, node->next_wdt - now);
+        mcu->cycles = node->next_wdt;
+    }
+    node->next_wdt += node->wdt_period;
+
+    if (node->app->watchdog_tick() && !overdue)
+        mcu->sr &= ~CPUOFF;
+}
+
+static void uart_tx_hook(host_mcu_t *mcu, const uint8_t *data, uint8_t count)
+{
+    Node *node = (Node *)mcu->user;
+
+    node->tx->insert(node->tx->end(), data, data + count);
+    node->frames++;
+
+    if (count == TELEMETRY_FRAME_MAX && data[3] == TELEMETRY_TYPE_SAMPLE &&
+        (data[TELEMETRY_HEADER_SIZE + TELEMETRY_STATUS] & TELEMETRY_STATUS_VALID)) {
+        const uint8_t *t = data + TELEMETRY_HEADER_SIZE + TELEMETRY_TEMPERATURE;
+
+        node->temp_count++;
+        node->temp_error += fabs((int16_t)(t[0] | t[1] << 8) / 10.0 - node->air_temperature);
+        node->raw_error += fabs(node->dht.temperature - node->air_temperature);
+    }
+}
+
+/* Slow random walk of the ambient around the node base values, and the
+ * board warming the DHT22 */
+static void update_environment(Node *node)
+{
+    double seconds = (double)(node->mcu.cycles - node->env_cycles) / FLEET_MCLK_HZ;
+    double steps = seconds / FLEET_ENV_STEP_S;
+    double hours = (double)node->mcu.cycles / FLEET_MCLK_HZ / 3600.0;
+
+    if (steps > 0.0) {
+        std::normal_distribution<double> step(0.0, 0.05 * sqrt(steps));
+
+        node->env_cycles = node->mcu.cycles;
+        node->air_temperature += step(node->rng) + (node->base_temperature - node->air_temperature) * 0.01 * steps;
+        node->dht.humidity += step(node->rng) * 4 + (node->base_humidity - node->dht.humidity) * 0.01 * steps;
+
+        node->oled_heat += ((node->oled.display_on ? 1.0 : 0.0) - node->oled_heat) *
+                           (1.0 - exp(-seconds / FLEET_OLED_TAU_S));
+        node->board_heat += (node->board_rise - node->board_heat) *
+                            (1.0 - exp(-seconds / FLEET_BOARD_TAU_S));
+        node->dht.temperature = node->air_temperature + node->oled_rise * node->oled_heat +
+                                node->board_share * node->board_heat;
+    }
+
+    /* ~10mV per virtual day */
+    node->battery_mv = 3250.0 - hours * 0.4;
+}
+
+static void create_node(unsigned n, uint64_t seed)
+{
+    std::unique_ptr<Node> node(new Node());
+    std::uniform_int_distribution<unsigned> vlo(FLEET_VLO_MIN_HZ, FLEET_VLO_MAX_HZ);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    node_config_t config;
+
+    node->rng.seed(seed + n);
+    node->wdt_period = FLEET_WDT_DIVIDER * FLEET_MCLK_HZ / vlo(node->rng);
+    /* Nodes power up at random within the first interval */
+    node->power_up = (uint64_t)(uniform(node->rng) * node->wdt_period);
+    node->mcu.cycles = node->power_up;
+    node->mcu.mclk_since = node->power_up;
+    node->env_cycles = node->power_up;
+    node->next_wdt = node->mcu.cycles + node->wdt_period;
+    node->started = false;
+    node->awake = true;
+
+    node->base_temperature = 15.0 + uniform(node->rng) * 15.0;
+    node->base_humidity = 35.0 + uniform(node->rng) * 40.0;
+    node->air_temperature = node->base_temperature;
+    node->dht.temperature = node->base_temperature;
+    node->dht.humidity = node->base_humidity;
+    node->battery_mv = 3250.0;
+    node->oled_rise = FLEET_OLED_RISE * (1.0 + FLEET_HEAT_SPREAD * (2.0 * uniform(node->rng) - 1.0));
+    node->board_rise = FLEET_BOARD_RISE * (1.0 + FLEET_HEAT_SPREAD * (2.0 * uniform(node->rng) - 1.0));
+    node->board_share = FLEET_BOARD_SHARE * (1.0 + FLEET_HEAT_SPREAD * (2.0 * uniform(node->rng) - 1.0));
+
+    node->mcu.user = node.get();
+    node->mcu.port_hook = port_hook;
+    node->mcu.sleep_hook = sleep_hook;
+    node->mcu.uart_tx_hook = uart_tx_hook;
+
+    config.magic = NODE_CONFIG_MAGIC;
+    config.address = n + 1;
+    memcpy(node->mcu.info_d, &config, sizeof(config));
+
+    /* Constructors write registers: select the node context */
+    host_mcu = &node->mcu;
+    host_i2c_attach(&node->oled);
+#ifdef OLED_SECOND_I2C_ADDRESS
+    host_i2c_attach(&node->oled2);
+#endif
+    node->app.reset(new ThermoHygrometer());
+
+    nodes.push_back(std::move(node));
+}
+
+/**
+ * @brief  Run one node up to end: main loop of main.cpp. While asleep
+ *         only the watchdog intervals run; RX bytes of the bus variant
+ *         are delivered between epochs.
+ */
+static void run_node(Node *node, Worker *worker, uint64_t end)
+{
+    uint64_t t0;
+
+    host_mcu = &node->mcu;
+    node->tx = &worker->tx;
+
+    while (node->mcu.cycles < end) {
+        if (!node->awake) {
+            if (node->next_wdt >= end) {
+                add_sleep(node, node->sleep_sr, end - node->mcu.cycles);
+                node->mcu.cycles = end;
+                break;
+            }
+
+            add_sleep(node, node->sleep_sr, node->next_wdt - node->mcu.cycles);
+            node->mcu.cycles = node->next_wdt;
+            node->next_wdt += node->wdt_period;
+            node->awake = node->app->watchdog_tick();
+            continue;
+        }
+
+        update_environment(node);
+
+        t0 = thread_cpu_ns();
+        if (!node->started) {
+            node->app->Init();
+            node->started = true;
+        }
+        else {
+            node->app->Update();
+        }
+        node->cpu_ns += thread_cpu_ns() - t0;
+        node->wakes++;
+
+        if (!node->first_reading && node->dht.reads)
+            node->first_reading = node->mcu.cycles - node->power_up;
+
+        /* Intervals that expired during Update() */
+        while (node->next_wdt <= node->mcu.cycles) {
+            node->next_wdt += node->wdt_period;
+            node->app->watchdog_tick();
+        }
+
+        node->awake = node->app->pending();
+        node->sleep_sr = node->app->sleep_bits();
+    }
+}
+
+#ifdef TELEMETRY_RS485
+/* Bytes from the collector: every node sees them, as on RS-485 */
+static void deliver_rx(const uint8_t *data, size_t size)
+{
+    size_t i;
+
+    for (auto &node : nodes) {
+        host_mcu = &node->mcu;
+
+        for (i=0; i < size; i++) {
+            UCA0RXBUF = data[i];
+            if (rs485_rx_isr())
+                node->awake = true;
+        }
+    }
+}
+#endif
+
+static void worker_main(Worker *worker)
+{
+    uint64_t seen = 0;
+    uint64_t end;
+    size_t n, i;
+
+    while (1) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            start_cv.wait(guard, [&] { return quit || generation != seen; });
+            if (quit)
+                return;
+            seen = generation;
+            end = epoch_end;
+        }
+
+        while ((n = next_node.fetch_add(FLEET_CHUNK)) < nodes.size())
+            for (i=n; i < n + FLEET_CHUNK && i < nodes.size(); i++)
+                run_node(nodes[i].get(), worker, end);
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (--busy == 0)
+                done_cv.notify_one();
+        }
+    }
+}
+
+static int open_output(const char *path)
+{
+    struct termios tio;
+    int fd;
+
+    if (!path)
+        return -1;
+    if (strcmp(path, "-") == 0)
+        return STDOUT_FILENO;
+
+#ifdef TELEMETRY_RS485
+    fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+#else
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_NOCTTY, 0644);
+#endif
+    if (fd < 0)
+        return -1;
+
+    /* Serial port or pty: raw bytes */
+    if (isatty(fd) && tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        cfsetospeed(&tio, B115200);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    return fd;
+}
+
+static bool write_all(int fd, const uint8_t *data, size_t size)
+{
+    ssize_t n;
+
+    while (size) {
+        n = write(fd, data, size);
+        if (n < 0 && errno == EAGAIN)
+            continue;
+        if (n <= 0)
+            return false;
+        data += n;
+        size -= n;
+    }
+
+    return true;
+}
+
+static int usage()
+{
+    fprintf(stderr, "usage: th-fleet [-n nodes] [-j threads] [-t seconds] [-s speed] [-e epoch ms]\n"
+                    "                [-o output]\n"
+                    "  -n  number of nodes (default 100)\n"
+                    "  -j  worker threads (default: hardware threads)\n"
+                    "  -t  virtual seconds to simulate (default 3600)\n"
+                    "  -s  virtual seconds per wall second, 0: unpaced (default %g)\n"
+                    "  -e  epoch length in virtual ms (default %d)\n"
+                    "  -o  telemetry output: file, FIFO, tty or '-' (default: none)\n"
+                    "  -r  random seed (default 1)\n", FLEET_SPEED, FLEET_EPOCH_MS);
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned node_count = 100;
+    unsigned threads = std::thread::hardware_concurrency();
+    double seconds = 3600;
+    double speed = FLEET_SPEED;
+    uint64_t epoch_cycles = FLEET_MCLK_HZ * FLEET_EPOCH_MS / 1000;
+    const char *output = NULL;
+    uint64_t seed = 1;
+    uint64_t end, epoch, wall_start, wall;
+    uint64_t wakes = 0, frames = 0, bytes = 0, cpu_ns = 0, cycles = 0, sleep_cycles = 0;
+    uint64_t mclk[HOST_MCLK_MHZ + 1] = { 0 };
+    uint64_t lpm0[HOST_MCLK_MHZ + 1] = { 0 };
+    uint64_t lpm3[HOST_MCLK_MHZ + 1] = { 0 };
+    uint64_t lpm3_total = 0;
+    uint64_t sensor_on = 0;
+    uint64_t oled_bytes = 0;
+    double charge = 0;
+    uint64_t first_total = 0, first_max = 0;
+    uint64_t temp_count = 0;
+    double temp_error = 0, raw_error = 0;
+    unsigned first_count = 0;
+    int fd, opt;
+    unsigned i, mhz;
+
+    while ((opt = getopt(argc, argv, "n:j:t:s:e:o:r:")) != -1) {
+        switch (opt) {
+        case 'n': node_count = atoi(optarg); break;
+        case 'j': threads = atoi(optarg); break;
+        case 't': seconds = atof(optarg); break;
+        case 's': speed = atof(optarg); break;
+        case 'e': epoch_cycles = (uint64_t)(atof(optarg) * FLEET_MCLK_HZ / 1000); break;
+        case 'o': output = optarg; break;
+        case 'r': seed = strtoull(optarg, NULL, 0); break;
+        default: return usage();
+        }
+    }
+
+    if (!node_count || node_count > 65534 || seconds <= 0 || !epoch_cycles)
+        return usage();
+    if (!threads)
+        threads = 1;
+
+    fd = open_output(output);
+    if (output && fd < 0) {
+        perror(output);
+        return 1;
+    }
+
+    for (i=0; i < node_count; i++)
+        create_node(i, seed);
+
+    for (i=0; i < threads; i++) {
+        std::unique_ptr<Worker> worker(new Worker());
+        worker->cpu_ns = 0;
+        worker->thread = std::thread(worker_main, worker.get());
+        workers.push_back(std::move(worker));
+    }
+
+    end = (uint64_t)(seconds * FLEET_MCLK_HZ);
+    wall_start = wall_ns();
+
+    for (epoch = epoch_cycles; ; epoch += epoch_cycles) {
+        if (epoch > end)
+            epoch = end;
+
+#ifdef TELEMETRY_RS485
+        if (fd >= 0) {
+            uint8_t rx[4096];
+            ssize_t n;
+
+            while ((n = read(fd, rx, sizeof(rx))) > 0)
+                deliver_rx(rx, n);
+        }
+#endif
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            epoch_end = epoch;
+            next_node = 0;
+            busy = threads;
+            generation++;
+            start_cv.notify_all();
+            done_cv.wait(guard, [] { return busy == 0; });
+        }
+
+        for (auto &worker : workers) {
+            if (fd >= 0 && !write_all(fd, worker->tx.data(), worker->tx.size())) {
+                perror(output);
+                fd = -1;
+            }
+            bytes += worker->tx.size();
+            worker->tx.clear();
+        }
+
+        if (epoch == end)
+            break;
+
+        /* Pace virtual time against the wall clock */
+        if (speed > 0) {
+            uint64_t due = wall_start + (uint64_t)(epoch * 1e9 / FLEET_MCLK_HZ / speed);
+
+            wall = wall_ns();
+            if (due > wall)
+                usleep((due - wall) / 1000);
+        }
+    }
+
+    wall = wall_ns() - wall_start;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        quit = true;
+        start_cv.notify_all();
+    }
+    for (auto &worker : workers)
+        worker->thread.join();
+
+    for (auto &node : nodes) {
+        wakes += node->wakes;
+        frames += node->frames;
+        temp_count += node->temp_count;
+        temp_error += node->temp_error;
+        raw_error += node->raw_error;
+        cpu_ns += node->cpu_ns;
+        cycles += node->mcu.cycles - node->power_up;
+        sleep_cycles += node->sleep_cycles;
+
+        if (node->first_reading) {
+            first_total += node->first_reading;
+            first_count++;
+            if (node->first_reading > first_max)
+                first_max = node->first_reading;
+        }
+
+        oled_bytes += node->oled.data_bytes;
+#ifdef OLED_SECOND_I2C_ADDRESS
+        oled_bytes += node->oled2.data_bytes;
+#endif
+
+        sensor_on += node->dht.powered_cycles(node->mcu.cycles);
+#ifndef SENSOR_POWER_GATED
+        /* Powered since cycle 0 of the model */
+        sensor_on -= node->power_up;
+#endif
+
+        host_mclk_account(&node->mcu);
+        for (mhz=0; mhz <= HOST_MCLK_MHZ; mhz++) {
+            mclk[mhz] += node->mcu.mclk_cycles[mhz];
+            lpm0[mhz] += node->lpm0_cycles[mhz];
+            lpm3[mhz] += node->lpm3_cycles[mhz];
+            lpm3_total += node->lpm3_cycles[mhz];
+        }
+    }
+
+    /* uA x cycles, per node: awake is the time at a clock minus the time
+     * asleep at it. The DCO is off in LPM3 */
+    for (auto &current : fleet_currents) {
+        mhz = current.mhz;
+        charge += (double)(mclk[mhz] - lpm0[mhz] - lpm3[mhz]) * current.awake_ua;
+        charge += (double)lpm0[mhz] * current.lpm0_ua;
+    }
+    charge += (double)lpm3_total * FLEET_LPM3_UA;
+
+    printf("nodes             %u on %u threads\n", node_count, threads);
+    printf("virtual time      %.0f s (%.1fx real time)\n", seconds, seconds / (wall / 1e9));
+    printf("wall time         %.3f s\n", wall / 1e9);
+    printf("wake-ups          %llu\n", (unsigned long long)wakes);
+    if (first_count)
+        printf("first reading     %.1f ms mean, %.1f ms max after power-up\n",
+               (double)first_total / first_count * 1e3 / FLEET_MCLK_HZ, first_max * 1e3 / FLEET_MCLK_HZ);
+    printf("frames            %llu (%llu bytes, %.1f frames/s wall)\n", (unsigned long long)frames,
+           (unsigned long long)bytes, frames / (wall / 1e9));
+    if (wakes) {
+        printf("host CPU/wake     %.1f us\n", cpu_ns / 1e3 / wakes);
+        printf("active time/wake  %.2f ms virtual\n",
+               (double)(cycles - sleep_cycles) / wakes * 1e3 / FLEET_MCLK_HZ);
+        printf("duty cycle        %.4f %%\n", 100.0 * (cycles - sleep_cycles) / cycles);
+    }
+    for (auto &current : fleet_currents) {
+        mhz = current.mhz;
+        if (!mclk[mhz])
+            continue;
+        printf("MCLK %2u MHz       awake %.2f ms/wake, LPM0 %.1f %%, LPM3 %.1f %%\n", mhz,
+               wakes ? (double)(mclk[mhz] - lpm0[mhz] - lpm3[mhz]) / wakes * 1e3 / FLEET_MCLK_HZ : 0.0,
+               100.0 * lpm0[mhz] / cycles, 100.0 * lpm3[mhz] / cycles);
+    }
+    printf("supply current    %.2f uA average per node (estimate)\n", charge / cycles);
+    printf("OLED data         %.0f bytes per panel per hour, %u panel(s)\n",
+           (double)oled_bytes / OLED_PANELS * 3600.0 * FLEET_MCLK_HZ / cycles,
+           OLED_PANELS);
+    printf("DHT22 supply      on %.1f %% of the time, %.2f uA average per node\n",
+           100.0 * sensor_on / cycles, FLEET_DHT22_UA * sensor_on / cycles);
+    if (temp_count)
+        printf("temperature error %.2f oC mean, DHT22 reading %.2f oC (self-heating)\n",
+               temp_error / temp_count, raw_error / temp_count);
+
+    if (fd > STDOUT_FILENO)
+        close(fd);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * FrameParser.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <string.h>
+
+#include <lib/crc.h>
+
+#include "FrameParser.h"
+
+FrameParser::FrameParser()
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * @brief  Find the next valid sample frame of buf, starting at *pos.
+ * @param  buf: received bytes.
+ *         len: number of bytes in buf.
+ *         pos: in: search start. out: first byte not consumed. When no
+ *              frame is returned, bytes from *pos on are the beginning
+ *              of an incomplete frame and must be kept for the next call.
+ *         view: payload of the frame found, pointing into buf.
+ *
+ * @retval true if a frame was found.
+ */
+bool FrameParser::next(const uint8_t *buf, size_t len, size_t *pos, TelemetryView *view)
+{
+    const uint8_t *frame;
+
+    while (next_frame(buf, len, pos, &frame)) {
+        if (frame[3] != TELEMETRY_TYPE_SAMPLE || frame[2] != TELEMETRY_SAMPLE_SIZE) {
+            stats.unknown++;
+            continue;
+        }
+
+        view->payload = frame + TELEMETRY_HEADER_SIZE;
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief  Find the next frame of buf with a valid CRC, of any type.
+ * @param  buf, len, pos: as in next().
+ *         frame: first byte (SYNC0) of the frame found, pointing into buf.
+ *
+ * @retval true if a frame was found.
+ */
+bool FrameParser::next_frame(const uint8_t *buf, size_t len, size_t *pos, const uint8_t **frame)
+{
+    size_t i = *pos;
+    size_t frame_size;
+    const uint8_t *f;
+    uint16_t crc;
+
+    while (i + TELEMETRY_HEADER_SIZE <= len) {
+        f = buf + i;
+
+        if (f[0] != TELEMETRY_SYNC0 || f[1] != TELEMETRY_SYNC1) {
+            /* Skip to the next SYNC0 candidate */
+            const uint8_t *sync = (const uint8_t *)memchr(f + 1, TELEMETRY_SYNC0, len - i - 1);
+            size_t next = sync ? sync - buf : len;
+
+            stats.skipped += next - i;
+            i = next;
+            continue;
+        }
+
+        /* Sync word inside data: no frame that long */
+        if (f[2] > FRAME_PARSER_MAX_PAYLOAD) {
+            stats.skipped++;
+            i++;
+            continue;
+        }
+
+        frame_size = TELEMETRY_HEADER_SIZE + f[2] + TELEMETRY_CRC_SIZE;
+        if (i + frame_size > len)
+            break;
+
+        crc = f[frame_size - 2] | f[frame_size - 1] << 8;
+        if (crc16_ccitt(f + 2, f[2] + 2) != crc) {
+            stats.crc_errors++;
+            stats.skipped++;
+            i++;
+            continue;
+        }
+
+        stats.frames++;
+        *frame = f;
+        *pos = i + frame_size;
+
+        return true;
+    }
+
+    *pos = i;
+
+    return false;
+}
@@ -0,0 +1,65 @@
+/*
+ * FrameParser.h : telemetry frame decoder for byte streams
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Frames are located and checked in place, in the buffer filled by
+ *      read(): a TelemetryView only points to the payload and decodes
+ *      the fields it is asked for. After a CRC error the parser slides
+ *      one byte and searches the next sync word.
+ */
+
+#ifndef HOST_GATEWAY_FRAMEPARSER_H_
+#define HOST_GATEWAY_FRAMEPARSER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/telemetry_frame.h>
+
+/* Longer LEN fields are taken as a false sync */
+#define FRAME_PARSER_MAX_PAYLOAD    64
+#define FRAME_PARSER_MAX_FRAME      (TELEMETRY_HEADER_SIZE + FRAME_PARSER_MAX_PAYLOAD + TELEMETRY_CRC_SIZE)
+
+class TelemetryView
+{
+public:
+    const uint8_t *payload;
+
+    uint16_t node() const { return u16(TELEMETRY_NODE); }
+    uint8_t status() const { return payload[TELEMETRY_STATUS]; }
+    uint16_t seq() const { return u16(TELEMETRY_SEQ); }
+    uint32_t timestamp() const { return u16(TELEMETRY_TIMESTAMP) | (uint32_t)u16(TELEMETRY_TIMESTAMP + 2) << 16; }
+    int16_t temperature() const { return (int16_t)u16(TELEMETRY_TEMPERATURE); }
+    uint16_t humidity() const { return u16(TELEMETRY_HUMIDITY); }
+    uint16_t battery_mv() const { return u16(TELEMETRY_BATTERY); }
+    uint16_t i2c_errors() const { return u16(TELEMETRY_I2C_ERRORS); }
+    uint16_t sensor_errors() const { return u16(TELEMETRY_SENSOR_ERRORS); }
+
+private:
+    uint16_t u16(uint8_t offset) const { return payload[offset] | payload[offset + 1] << 8; }
+};
+
+struct FrameParserStats {
+    uint64_t frames;        /* valid CRC */
+    uint64_t crc_errors;
+    uint64_t unknown;       /* valid CRC, type not handled by next() */
+    uint64_t skipped;       /* bytes discarded while searching sync */
+};
+
+class FrameParser
+{
+public:
+    FrameParser();
+
+    bool next(const uint8_t *buf, size_t len, size_t *pos, TelemetryView *view);
+    bool next_frame(const uint8_t *buf, size_t len, size_t *pos, const uint8_t **frame);
+
+    const FrameParserStats &get_stats() { return stats; }
+
+private:
+    FrameParserStats stats;
+};
+
+#endif /* HOST_GATEWAY_FRAMEPARSER_H_ */
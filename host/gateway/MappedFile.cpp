@@ -0,0 +1,116 @@
+/*
+ * MappedFile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+/* Files grow in whole pages, doubling each time */
+#define MAPPED_FILE_MIN_SIZE    4096
+
+MappedFile::MappedFile() : fd(-1), writable(false), map(NULL), map_size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+/**
+ * @brief  Open and map the whole file. A writable file is created if
+ *         missing; new space always reads as zero.
+ * @param  path: file name.
+ *         writable: map for writing.
+ *
+ * @retval true on success.
+ */
+bool MappedFile::open(const char *path, bool writable)
+{
+    struct stat st;
+
+    close();
+
+    this->writable = writable;
+    fd = ::open(path, writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+    if (fd < 0)
+        return false;
+
+    if (fstat(fd, &st) < 0) {
+        close();
+        return false;
+    }
+
+    if (st.st_size == 0) {
+        if (!writable) {
+            close();
+            return false;
+        }
+        return reserve(MAPPED_FILE_MIN_SIZE);
+    }
+
+    map = (uint8_t *)mmap(NULL, st.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                          MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        map = NULL;
+        close();
+        return false;
+    }
+    map_size = st.st_size;
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (map)
+        munmap(map, map_size);
+    if (fd >= 0)
+        ::close(fd);
+
+    fd = -1;
+    map = NULL;
+    map_size = 0;
+}
+
+bool MappedFile::reserve(size_t size)
+{
+    size_t new_size = map_size ? map_size : MAPPED_FILE_MIN_SIZE;
+    uint8_t *new_map;
+
+    if (size <= map_size)
+        return true;
+    if (!writable || fd < 0)
+        return false;
+
+    while (new_size < size)
+        new_size *= 2;
+
+    if (ftruncate(fd, new_size) < 0)
+        return false;
+
+    new_map = (uint8_t *)mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (new_map == MAP_FAILED)
+        return false;
+
+    if (map)
+        munmap(map, map_size);
+
+    map = new_map;
+    map_size = new_size;
+
+    return true;
+}
+
+void MappedFile::sync()
+{
+    if (map && writable)
+        msync(map, map_size, MS_ASYNC);
+}
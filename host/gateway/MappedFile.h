@@ -0,0 +1,38 @@
+/*
+ * MappedFile.h : file mapped in memory that grows on demand
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#ifndef HOST_GATEWAY_MAPPEDFILE_H_
+#define HOST_GATEWAY_MAPPEDFILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const char *path, bool writable);
+    void close();
+
+    /* Grow (writable only) so at least size bytes are mapped.
+     * Invalidates pointers returned by data(). */
+    bool reserve(size_t size);
+    void sync();
+
+    uint8_t *data() { return map; }
+    size_t size() { return map_size; }
+
+private:
+    int fd;
+    bool writable;
+    uint8_t *map;
+    size_t map_size;
+};
+
+#endif /* HOST_GATEWAY_MAPPEDFILE_H_ */
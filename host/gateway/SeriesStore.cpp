@@ -0,0 +1,353 @@
+/*
+ * SeriesStore.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "SeriesStore.h"
+
+#define SERIES_MAGIC            "THSERIES"
+#define SERIES_VERSION          1
+
+/* Longest zigzag varint of a 64-bit value */
+#define VARINT_MAX_SIZE         10
+
+static const char *column_name[SeriesStore::COLUMNS] = {
+    "time", "temp", "humid", "battery"
+};
+
+static uint8_t *put_varint(uint8_t *p, int64_t value)
+{
+    uint64_t zigzag = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+
+    while (zigzag >= 0x80) {
+        *p++ = zigzag | 0x80;
+        zigzag >>= 7;
+    }
+    *p++ = zigzag;
+
+    return p;
+}
+
+/* NULL if the varint runs past end: the block is still being written */
+static const uint8_t *get_varint(const uint8_t *p, const uint8_t *end, int64_t *value)
+{
+    uint64_t zigzag = 0;
+    unsigned shift = 0;
+
+    do {
+        if (p >= end || shift >= 64)
+            return NULL;
+        zigzag |= (uint64_t)(*p & 0x7F) << shift;
+        shift += 7;
+    } while (*p++ & 0x80);
+
+    *value = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+
+    return p;
+}
+
+SeriesStore::SeriesStore()
+{
+}
+
+/**
+ * @brief  Open the files of one node. A writable store is created if
+ *         it does not exist.
+ * @param  dir: store root directory.
+ *         node: node address.
+ *         writable: open for append.
+ *
+ * @retval true on success.
+ */
+bool SeriesStore::open(const std::string &dir, uint16_t node, bool writable)
+{
+    char name[16];
+    std::string path;
+    int n;
+
+    snprintf(name, sizeof(name), "node_%05u", node);
+    path = dir + "/" + name;
+
+    if (writable && mkdir(path.c_str(), 0755) < 0 && errno != EEXIST)
+        return false;
+
+    if (!index.open((path + "/index").c_str(), writable))
+        return false;
+
+    for (n=0; n < COLUMNS; n++)
+        if (!column[n].open((path + "/" + column_name[n]).c_str(), writable))
+            return false;
+
+    if (index.size() < sizeof(IndexHeader))
+        return false;
+
+    /* New file: all zero */
+    if (header()->magic[0] == 0) {
+        memcpy(header()->magic, SERIES_MAGIC, sizeof(header()->magic));
+        header()->version = SERIES_VERSION;
+        header()->node = node;
+    }
+
+    return memcmp(header()->magic, SERIES_MAGIC, sizeof(header()->magic)) == 0 &&
+           header()->version == SERIES_VERSION;
+}
+
+/**
+ * @brief  Append one sample.
+ * @param  value: one value per column. Time must not go backwards.
+ *
+ * @retval false if a file could not grow.
+ */
+bool SeriesStore::append(const int64_t value[COLUMNS])
+{
+    IndexHeader *h = header();
+    Block *b;
+    uint8_t *p;
+    int n;
+
+    /* Current block full or none yet: open a new one */
+    if (h->blocks == 0 || block(h->blocks - 1)->count == SERIES_BLOCK_SAMPLES) {
+        if (!index.reserve(sizeof(IndexHeader) + (h->blocks + 1) * sizeof(Block)))
+            return false;
+
+        h = header();
+        b = block(h->blocks);
+
+        for (n=0; n < COLUMNS; n++) {
+            b->offset[n] = h->used[n];
+            b->last[n] = 0;
+            b->min[n] = value[n];
+            b->max[n] = value[n];
+            b->sum[n] = 0;
+        }
+        b->first_time = value[TIME];
+        b->count = 0;
+        h->blocks++;
+    }
+
+    b = block(h->blocks - 1);
+
+    for (n=0; n < COLUMNS; n++) {
+        if (!column[n].reserve(h->used[n] + VARINT_MAX_SIZE))
+            return false;
+
+        p = put_varint(column[n].data() + h->used[n], value[n] - b->last[n]);
+        h->used[n] = p - column[n].data();
+
+        b->last[n] = value[n];
+        if (value[n] < b->min[n])
+            b->min[n] = value[n];
+        if (value[n] > b->max[n])
+            b->max[n] = value[n];
+        b->sum[n] += value[n];
+    }
+
+    /* Sample becomes visible to readers last */
+    b->count++;
+    h->samples++;
+
+    return true;
+}
+
+void SeriesStore::sync()
+{
+    int n;
+
+    for (n=0; n < COLUMNS; n++)
+        column[n].sync();
+    index.sync();
+}
+
+uint64_t SeriesStore::get_count()
+{
+    return header()->samples;
+}
+
+/**
+ * @brief  Add the samples of one block with time in [from, to].
+ *         Blocks fully inside the range use the index summary only.
+ */
+void SeriesStore::add_block(const Block *b, int64_t from, int64_t to, Summary *summary)
+{
+    const uint8_t *p[COLUMNS];
+    const uint8_t *end[COLUMNS];
+    int64_t value[COLUMNS] = {0};
+    int64_t delta;
+    uint32_t i;
+    int n;
+
+    if (b->first_time >= from && b->max[TIME] <= to) {
+        for (n=0; n < COLUMNS; n++) {
+            if (!summary->count || b->min[n] < summary->min[n])
+                summary->min[n] = b->min[n];
+            if (!summary->count || b->max[n] > summary->max[n])
+                summary->max[n] = b->max[n];
+            summary->sum[n] += b->sum[n];
+        }
+        summary->count += b->count;
+        return;
+    }
+
+    for (n=0; n < COLUMNS; n++) {
+        p[n] = column[n].data() + b->offset[n];
+        end[n] = column[n].data() + column[n].size();
+    }
+
+    for (i=0; i < b->count; i++) {
+        for (n=0; n < COLUMNS; n++) {
+            p[n] = get_varint(p[n], end[n], &delta);
+            if (!p[n])
+                return;
+            value[n] += delta;
+        }
+
+        if (value[TIME] < from)
+            continue;
+        if (value[TIME] > to)
+            break;
+
+        for (n=0; n < COLUMNS; n++) {
+            if (!summary->count || value[n] < summary->min[n])
+                summary->min[n] = value[n];
+            if (!summary->count || value[n] > summary->max[n])
+                summary->max[n] = value[n];
+            summary->sum[n] += value[n];
+        }
+        summary->count++;
+    }
+}
+
+/**
+ * @brief  Min, max and sum of every column over the samples with time
+ *         in [from, to] (ms).
+ * @param  summary: result. count is zero if the range is empty.
+ *
+ * @retval Nenhum.
+ */
+void SeriesStore::query(int64_t from, int64_t to, Summary *summary)
+{
+    uint64_t blocks = get_blocks();
+    uint64_t n;
+
+    memset(summary, 0, sizeof(*summary));
+
+    for (n=find_block(from); n < blocks && block(n)->first_time <= to; n++)
+        if (block(n)->count)
+            add_block(block(n), from, to, summary);
+}
+
+/**
+ * @brief  Decode every sample with time in [from, to] (ms), in order.
+ * @param  visit: called with the columns of each sample.
+ *
+ * @retval Nenhum.
+ */
+void SeriesStore::scan(int64_t from, int64_t to, Visitor visit, void *arg)
+{
+    uint64_t blocks = get_blocks();
+    const uint8_t *p[COLUMNS];
+    const uint8_t *end[COLUMNS];
+    int64_t value[COLUMNS];
+    int64_t delta;
+    uint64_t b;
+    uint32_t i;
+    int n;
+
+    for (b=find_block(from); b < blocks && block(b)->first_time <= to; b++) {
+        for (n=0; n < COLUMNS; n++) {
+            p[n] = column[n].data() + block(b)->offset[n];
+            end[n] = column[n].data() + column[n].size();
+            value[n] = 0;
+        }
+
+        for (i=0; i < block(b)->count; i++) {
+            for (n=0; n < COLUMNS; n++) {
+                p[n] = get_varint(p[n], end[n], &delta);
+                if (!p[n])
+                    return;
+                value[n] += delta;
+            }
+
+            if (value[TIME] < from)
+                continue;
+            if (value[TIME] > to)
+                return;
+
+            visit(value, arg);
+        }
+    }
+}
+
+/**
+ * @brief  Whether the samples of block n lie inside the mapped columns.
+ *         The block ends where the next one starts, the last one at the
+ *         bytes used.
+ */
+bool SeriesStore::block_mapped(uint64_t n)
+{
+    uint64_t end;
+    int c;
+
+    for (c=0; c < COLUMNS; c++) {
+        end = n + 1 < header()->blocks ? block(n + 1)->offset[c] : header()->used[c];
+        if (end > column[c].size())
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  Blocks a reader can use. A reader maps the files once at
+ *         open() while ingest may keep appending and growing them, so
+ *         the header can count blocks and bytes past the end of the
+ *         mappings of the reader. Block offsets grow with the block
+ *         number: the usable blocks are a prefix.
+ * @retval header()->blocks clamped to the mapped index and columns.
+ */
+uint64_t SeriesStore::get_blocks()
+{
+    uint64_t blocks = header()->blocks;
+    uint64_t mapped = (index.size() - sizeof(IndexHeader)) / sizeof(Block);
+    uint64_t lo = 0, mid;
+
+    /* The end of a block is in the next entry: it must be mapped too */
+    if (blocks > mapped)
+        blocks = mapped ? mapped - 1 : 0;
+
+    while (lo < blocks) {
+        mid = (lo + blocks) / 2;
+        if (block_mapped(mid))
+            lo = mid + 1;
+        else
+            blocks = mid;
+    }
+
+    return lo;
+}
+
+/**
+ * @brief  First block ending at or after from: time is monotonic.
+ * @retval Block number, get_blocks() if none.
+ */
+uint64_t SeriesStore::find_block(int64_t from)
+{
+    uint64_t lo = 0, hi = get_blocks(), mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (block(mid)->max[TIME] < from)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
@@ -0,0 +1,98 @@
+/*
+ * SeriesStore.h : per node time series in memory-mapped column files
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      One directory per node, one file per column:
+ *
+ *          node_00001/index      block index
+ *          node_00001/time       sample time, ms since epoch
+ *          node_00001/temp       tenths of oC
+ *          node_00001/humid      tenths of %RH
+ *          node_00001/battery    mV
+ *
+ *      Column files hold zigzag varint deltas to the previous sample of
+ *      the same block: a slowly changing reading takes one byte. Samples
+ *      are grouped in blocks of SERIES_BLOCK_SAMPLES; each index entry has
+ *      the byte offset of the block in every column plus its time span
+ *      and min/max/sum. A range query reads the index, uses the summaries
+ *      of the blocks fully inside the range and decodes only the blocks
+ *      at its ends.
+ */
+
+#ifndef HOST_GATEWAY_SERIESSTORE_H_
+#define HOST_GATEWAY_SERIESSTORE_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "MappedFile.h"
+
+#define SERIES_BLOCK_SAMPLES    256
+
+class SeriesStore
+{
+public:
+    enum Column {
+        TIME,
+        TEMPERATURE,
+        HUMIDITY,
+        BATTERY,
+        COLUMNS
+    };
+
+    struct Summary {
+        uint64_t count;
+        int64_t min[COLUMNS];
+        int64_t max[COLUMNS];
+        int64_t sum[COLUMNS];
+    };
+
+    /* Called by scan() with the columns of each sample */
+    typedef void (*Visitor)(const int64_t value[COLUMNS], void *arg);
+
+    SeriesStore();
+
+    bool open(const std::string &dir, uint16_t node, bool writable);
+    bool append(const int64_t value[COLUMNS]);
+    void sync();
+
+    uint64_t get_count();
+    void query(int64_t from, int64_t to, Summary *summary);
+    void scan(int64_t from, int64_t to, Visitor visit, void *arg);
+
+private:
+    struct IndexHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t node;
+        uint64_t samples;
+        uint64_t blocks;
+        uint64_t used[COLUMNS];     /* bytes written in each column file */
+    };
+
+    struct Block {
+        uint64_t offset[COLUMNS];
+        int64_t last[COLUMNS];      /* delta reference of the next sample */
+        int64_t min[COLUMNS];
+        int64_t max[COLUMNS];
+        int64_t sum[COLUMNS];
+        int64_t first_time;
+        uint32_t count;
+        uint32_t reserved;
+    };
+
+    IndexHeader *header() { return (IndexHeader *)index.data(); }
+    Block *block(uint64_t n) { return (Block *)(index.data() + sizeof(IndexHeader)) + n; }
+
+    uint64_t get_blocks();
+    bool block_mapped(uint64_t n);
+    uint64_t find_block(int64_t from);
+    void add_block(const Block *b, int64_t from, int64_t to, Summary *summary);
+
+    MappedFile index;
+    MappedFile column[COLUMNS];
+};
+
+#endif /* HOST_GATEWAY_SERIESSTORE_H_ */
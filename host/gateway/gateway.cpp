@@ -0,0 +1,724 @@
+/*
+ * gateway.cpp : collects node telemetry into per node time series
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      g++ -std=c++14 -O2 -I CPP -o th-gateway host/gateway/gateway.cpp \
+ *          host/gateway/FrameParser.cpp host/gateway/SeriesStore.cpp \
+ *          host/gateway/MappedFile.cpp -x c CPP/lib/crc.c \
+ *          CPP/lib/telemetry_frame.c
+ *
+ *      th-gateway ingest <store> <tty|file|--pty>...
+ *          Reads telemetry frames from serial ports (115200 8N1), capture
+ *          files or a pseudo terminal created here (its slave name is
+ *          printed; write node traffic to it) and appends valid samples
+ *          to <store>/node_NNNNN. Stops on SIGINT/SIGTERM or when every
+ *          input reached end of file.
+ *
+ *      th-gateway poll <store> <tty|--pty> <first> <last> [timeout ms]
+ *          Collector of a polled RS-485 bus: POLLs nodes first..last in
+ *          turn with the last sequence number received from each and
+ *          stores the samples of the BATCH replies. The line is half
+ *          duplex, so the next POLL goes out as soon as the last byte of
+ *          a reply is in; the reply is decoded and stored while the next
+ *          node answers. Silent nodes are polled again after a growing
+ *          back-off, so dead addresses cost little bus time.
+ *
+ *      th-gateway query <store> <node> [from [to]]
+ *          Count, min, max and mean of each column over a time range in
+ *          seconds since epoch (default: everything).
+ *
+ *      th-gateway dump <store> <node> [from [to]]
+ *          One line per sample in the range: time in ms, temperature and
+ *          humidity in tenths, battery in mV.
+ *
+ *      Sample times come from the node: its frames carry the uptime in
+ *      watchdog intervals. The first sample of a node, and the first one
+ *      after it resets, pins that uptime to the reception time; later
+ *      samples are placed GATEWAY_WDT_TICK_MS per interval after it. A
+ *      capture replayed from a file so keeps the spacing it was recorded
+ *      with, and the samples of a BATCH reply get their own times.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FrameParser.h"
+#include "SeriesStore.h"
+
+#define GATEWAY_MAX_INPUTS      64
+#define GATEWAY_READ_SIZE       4096
+
+/* Flush mapped files to disk every N ms */
+#define GATEWAY_SYNC_MS         5000
+
+/* Polled bus: reply timeout and back-off of silent nodes */
+#define GATEWAY_POLL_TIMEOUT_MS     100
+#define GATEWAY_POLL_BACKOFF_MS     250
+#define GATEWAY_POLL_BACKOFF_MAX_MS 30000
+#define GATEWAY_LINE_BPS            115200
+
+/* WDT_ADLY_1000 on the VLO at its typical 12kHz: 32768 / 12000 s */
+#define GATEWAY_WDT_TICK_MS     2731
+
+struct Input {
+    std::string name;
+    int fd;
+    int keep_fd;        /* pty slave held open so the master never hangs up */
+    bool stream;        /* tty/pty: no end of file */
+    size_t pending;     /* incomplete frame kept at the start of buf */
+    FrameParser parser;
+    uint8_t buf[FRAME_PARSER_MAX_FRAME + GATEWAY_READ_SIZE];
+};
+
+struct NodeState {
+    std::unique_ptr<SeriesStore> store;
+    bool seen;
+    uint16_t seq;
+    uint32_t ticks;         /* node timestamp of the last sample */
+    uint32_t anchor_ticks;  /* node timestamp received at anchor_time */
+    int64_t anchor_time;
+    int64_t last_time;
+    uint64_t samples;
+    uint64_t invalid;
+    uint64_t causes[TELEMETRY_STATUS_CAUSES];
+    uint64_t lost;
+    uint64_t reboots;
+};
+
+/* Invalid sample causes: DHT22_x order of CPP/Dht22.h */
+static const char *cause_names[TELEMETRY_STATUS_CAUSES] = {
+    "unknown", "no response", "no release", "timeout", "checksum"
+};
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int)
+{
+    stop = 1;
+}
+
+static int64_t mono_ms()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static int64_t now_ms()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static bool open_tty(Input *in, int mode = O_RDONLY)
+{
+    struct termios tio;
+
+    in->fd = open(in->name.c_str(), mode | O_NOCTTY | O_NONBLOCK);
+    if (in->fd < 0)
+        return false;
+
+    in->stream = isatty(in->fd);
+    if (!in->stream)
+        return true;
+
+    if (tcgetattr(in->fd, &tio) < 0)
+        return false;
+
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tio.c_cflag |= CLOCAL | CREAD;
+
+    return tcsetattr(in->fd, TCSANOW, &tio) == 0;
+}
+
+static bool open_pty(Input *in)
+{
+    struct termios tio;
+    const char *slave;
+
+    in->fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (in->fd < 0 || grantpt(in->fd) < 0 || unlockpt(in->fd) < 0)
+        return false;
+
+    slave = ptsname(in->fd);
+    if (!slave)
+        return false;
+
+    in->name = slave;
+    in->stream = true;
+    in->keep_fd = open(slave, O_RDWR | O_NOCTTY);
+    if (in->keep_fd < 0)
+        return false;
+
+    /* Raw bytes: no echo, no line discipline */
+    if (tcgetattr(in->keep_fd, &tio) < 0)
+        return false;
+    cfmakeraw(&tio);
+    if (tcsetattr(in->keep_fd, TCSANOW, &tio) < 0)
+        return false;
+
+    printf("pty %s\n", slave);
+    fflush(stdout);
+
+    return true;
+}
+
+static NodeState *get_node(std::map<uint16_t, NodeState> &nodes, const std::string &dir, uint16_t node)
+{
+    NodeState &state = nodes[node];
+
+    if (!state.store) {
+        state.store.reset(new SeriesStore());
+        if (!state.store->open(dir, node, true)) {
+            fprintf(stderr, "cannot open store of node %u in %s\n", node, dir.c_str());
+            return NULL;
+        }
+    }
+
+    return &state;
+}
+
+/**
+ * @brief  Store one sample at the time given by its node timestamp.
+ * @param  received: reception time, ms since epoch.
+ * @param  received_ticks: newest node timestamp of that reception: the
+ *         sample's own one for single frames, the last sample's for a
+ *         BATCH reply.
+ */
+static void store_sample(std::map<uint16_t, NodeState> &nodes, const std::string &dir,
+                         const TelemetryView &view, int64_t received, uint32_t received_ticks)
+{
+    NodeState *state = get_node(nodes, dir, view.node());
+    int64_t value[SeriesStore::COLUMNS];
+    int64_t time;
+    bool reset;
+
+    if (!state)
+        return;
+
+    reset = !state->seen;
+
+    /* Sequence gap: frames lost on the line. Going backwards: node reset */
+    if (state->seen) {
+        uint16_t gap = view.seq() - state->seq - 1;
+
+        if (gap >= 0x8000 || view.timestamp() < state->ticks) {
+            state->reboots++;
+            reset = true;
+        } else
+            state->lost += gap;
+    }
+    state->seen = true;
+    state->seq = view.seq();
+    state->ticks = view.timestamp();
+
+    /* Uptime restarted: pin it to the reception time again */
+    if (reset) {
+        state->anchor_ticks = received_ticks;
+        state->anchor_time = received;
+    }
+
+    if (!(view.status() & TELEMETRY_STATUS_VALID)) {
+        state->invalid++;
+        state->causes[TELEMETRY_STATUS_CAUSE(view.status())]++;
+        return;
+    }
+
+    time = state->anchor_time + ((int64_t)view.timestamp() - state->anchor_ticks) * GATEWAY_WDT_TICK_MS;
+
+    /* Time column must be monotonic */
+    if (time < state->last_time)
+        time = state->last_time;
+    state->last_time = time;
+
+    value[SeriesStore::TIME] = time;
+    value[SeriesStore::TEMPERATURE] = view.temperature();
+    value[SeriesStore::HUMIDITY] = view.humidity();
+    value[SeriesStore::BATTERY] = view.battery_mv();
+
+    if (state->store->append(value))
+        state->samples++;
+}
+
+static void report_nodes(std::map<uint16_t, NodeState> &nodes)
+{
+    for (auto &node : nodes) {
+        NodeState &s = node.second;
+
+        if (s.store)
+            s.store->sync();
+        fprintf(stderr, "node %5u: %llu samples, %llu invalid, %llu lost, %llu resets\n",
+                node.first, (unsigned long long)s.samples, (unsigned long long)s.invalid,
+                (unsigned long long)s.lost, (unsigned long long)s.reboots);
+        for (int i = 0; i < TELEMETRY_STATUS_CAUSES; i++) {
+            if (s.causes[i])
+                fprintf(stderr, "            %llu %s\n", (unsigned long long)s.causes[i], cause_names[i]);
+        }
+    }
+}
+
+static int ingest(const std::string &dir, int argc, char **argv)
+{
+    std::vector<std::unique_ptr<Input>> inputs;
+    std::map<uint16_t, NodeState> nodes;
+    int64_t last_sync = now_ms();
+    int open_inputs;
+    int i;
+
+    if (mkdir(dir.c_str(), 0755) < 0 && errno != EEXIST) {
+        perror(dir.c_str());
+        return 1;
+    }
+
+    if (argc < 1)
+        return 2;
+
+    if (argc > GATEWAY_MAX_INPUTS) {
+        fprintf(stderr, "at most %d inputs\n", GATEWAY_MAX_INPUTS);
+        return 1;
+    }
+
+    for (i=0; i < argc; i++) {
+        std::unique_ptr<Input> in(new Input());
+
+        in->name = argv[i];
+        in->keep_fd = -1;
+        in->pending = 0;
+
+        if (!(strcmp(argv[i], "--pty") == 0 ? open_pty(in.get()) : open_tty(in.get()))) {
+            perror(argv[i]);
+            return 1;
+        }
+        inputs.push_back(std::move(in));
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    std::vector<struct pollfd> fds(inputs.size());
+    open_inputs = inputs.size();
+
+    while (!stop && open_inputs) {
+        for (i=0; i < (int)inputs.size(); i++) {
+            fds[i].fd = inputs[i]->fd;
+            fds[i].events = POLLIN;
+        }
+
+        if (poll(fds.data(), fds.size(), GATEWAY_SYNC_MS) < 0 && errno != EINTR)
+            break;
+
+        for (i=0; i < (int)inputs.size(); i++) {
+            Input *in = inputs[i].get();
+            TelemetryView view;
+            int64_t received;
+            ssize_t n;
+            size_t pos = 0;
+
+            if (in->fd < 0 || !(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+
+            n = read(in->fd, in->buf + in->pending, GATEWAY_READ_SIZE);
+            if (n < 0 && (errno == EAGAIN || errno == EINTR))
+                continue;
+            if (n <= 0) {
+                close(in->fd);
+                in->fd = -1;
+                open_inputs--;
+                continue;
+            }
+
+            received = now_ms();
+            n += in->pending;
+
+            while (in->parser.next(in->buf, n, &pos, &view))
+                store_sample(nodes, dir, view, received, view.timestamp());
+
+            /* Keep the incomplete frame for the next read */
+            in->pending = n - pos;
+            memmove(in->buf, in->buf + pos, in->pending);
+        }
+
+        if (now_ms() - last_sync >= GATEWAY_SYNC_MS) {
+            for (auto &node : nodes)
+                if (node.second.store)
+                    node.second.store->sync();
+            last_sync = now_ms();
+        }
+    }
+
+    report_nodes(nodes);
+
+    for (auto &in : inputs) {
+        const FrameParserStats &st = in->parser.get_stats();
+
+        fprintf(stderr, "%s: %llu frames, %llu crc errors, %llu unknown, %llu bytes skipped\n",
+                in->name.c_str(), (unsigned long long)st.frames, (unsigned long long)st.crc_errors,
+                (unsigned long long)st.unknown, (unsigned long long)st.skipped);
+        if (in->fd >= 0)
+            close(in->fd);
+        if (in->keep_fd >= 0)
+            close(in->keep_fd);
+    }
+
+    return 0;
+}
+
+/* Collector side of one bus address */
+struct BusNodeState {
+    uint16_t since;         /* last sequence number received */
+    uint16_t misses;        /* consecutive polls without reply */
+    int64_t due;            /* next poll, mono_ms() */
+};
+
+struct BusStats {
+    uint64_t polls;
+    uint64_t replies;
+    uint64_t timeouts;
+    uint64_t samples;
+    uint64_t bytes;         /* sent and received */
+};
+
+static void send_poll(Input *bus, uint16_t node, uint16_t since, BusStats *stats)
+{
+    uint8_t frame[TELEMETRY_HEADER_SIZE + TELEMETRY_POLL_SIZE + TELEMETRY_CRC_SIZE];
+    uint8_t *payload = frame + TELEMETRY_HEADER_SIZE;
+    uint8_t size;
+
+    payload[TELEMETRY_POLL_NODE] = node;
+    payload[TELEMETRY_POLL_NODE + 1] = node >> 8;
+    payload[TELEMETRY_POLL_SINCE] = since;
+    payload[TELEMETRY_POLL_SINCE + 1] = since >> 8;
+    payload[TELEMETRY_POLL_MAX] = TELEMETRY_BATCH_MAX;
+    size = telemetry_close(frame, TELEMETRY_TYPE_POLL, TELEMETRY_POLL_SIZE);
+
+    if (write(bus->fd, frame, size) == size) {
+        stats->polls++;
+        stats->bytes += size;
+    }
+}
+
+/**
+ * @brief  Next address to poll: round robin over the nodes due.
+ * @retval Address, or -1 when every node is backing off.
+ */
+static int next_address(std::vector<BusNodeState> &bus_nodes, unsigned first, unsigned *turn, int64_t now)
+{
+    size_t i, n;
+
+    for (i=0; i < bus_nodes.size(); i++) {
+        n = (*turn + i) % bus_nodes.size();
+        if (bus_nodes[n].due <= now) {
+            *turn = n + 1;
+            return first + n;
+        }
+    }
+
+    return -1;
+}
+
+static int poll_bus(const std::string &dir, int argc, char **argv)
+{
+    std::unique_ptr<Input> bus(new Input());
+    std::map<uint16_t, NodeState> nodes;
+    std::vector<BusNodeState> bus_nodes;
+    std::vector<uint8_t> reply;
+    std::vector<uint32_t> reply_ticks;  /* newest timestamp of each sample's batch */
+    BusStats stats;
+    unsigned first, last, turn = 0;
+    int timeout_ms = GATEWAY_POLL_TIMEOUT_MS;
+    int64_t start, sent = 0, last_sync = mono_ms();
+    int waiting = -1;
+    int64_t now;
+
+    if (argc < 3)
+        return 2;
+
+    first = atoi(argv[1]);
+    last = atoi(argv[2]);
+    if (argc > 3)
+        timeout_ms = atoi(argv[3]);
+    if (!first || last < first || last > 0xFFFE || timeout_ms <= 0)
+        return 2;
+
+    if (mkdir(dir.c_str(), 0755) < 0 && errno != EEXIST) {
+        perror(dir.c_str());
+        return 1;
+    }
+
+    bus->name = argv[0];
+    bus->keep_fd = -1;
+    bus->pending = 0;
+    if (!(strcmp(argv[0], "--pty") == 0 ? open_pty(bus.get()) : open_tty(bus.get(), O_RDWR))) {
+        perror(argv[0]);
+        return 1;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    bus_nodes.resize(last - first + 1);
+    for (auto &b : bus_nodes) {
+        /* Ahead of any sample: the node restarts from its oldest one */
+        b.since = 0xFFFF;
+        b.misses = 0;
+        b.due = 0;
+    }
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    start = mono_ms();
+
+    while (!stop) {
+        struct pollfd pfd;
+        const uint8_t *frame;
+        size_t pos = 0;
+        ssize_t n;
+        int wait;
+
+        now = mono_ms();
+
+        if (waiting < 0) {
+            waiting = next_address(bus_nodes, first, &turn, now);
+            if (waiting >= 0) {
+                send_poll(bus.get(), waiting, bus_nodes[waiting - first].since, &stats);
+                sent = now;
+            }
+        }
+
+        wait = waiting >= 0 ? (int)(sent + timeout_ms - now) : GATEWAY_POLL_BACKOFF_MS;
+        if (wait < 0)
+            wait = 0;
+
+        pfd.fd = bus->fd;
+        pfd.events = POLLIN;
+        if (poll(&pfd, 1, wait) < 0 && errno != EINTR)
+            break;
+
+        n = 0;
+        if (pfd.revents & POLLIN) {
+            n = read(bus->fd, bus->buf + bus->pending, GATEWAY_READ_SIZE);
+            if (n < 0 && errno != EAGAIN && errno != EINTR)
+                break;
+            if (n < 0)
+                n = 0;
+        }
+        stats.bytes += n;
+        n += bus->pending;
+
+        reply.clear();
+        reply_ticks.clear();
+        while (bus->parser.next_frame(bus->buf, n, &pos, &frame)) {
+            const uint8_t *payload = frame + TELEMETRY_HEADER_SIZE;
+            BusNodeState *b;
+            TelemetryView view;
+            uint8_t count;
+
+            /* Own POLLs echoed by the transceiver, late replies */
+            if (frame[3] != TELEMETRY_TYPE_BATCH || frame[2] < TELEMETRY_BATCH_SAMPLES || waiting < 0 ||
+                (payload[TELEMETRY_BATCH_NODE] | payload[TELEMETRY_BATCH_NODE + 1] << 8) != waiting)
+                continue;
+
+            count = payload[TELEMETRY_BATCH_COUNT];
+            if (frame[2] != TELEMETRY_BATCH_SAMPLES + count * TELEMETRY_SAMPLE_SIZE)
+                continue;
+
+            b = &bus_nodes[waiting - first];
+            b->misses = 0;
+            stats.replies++;
+
+            if (count) {
+                view.payload = payload + TELEMETRY_BATCH_SAMPLES + (count - 1) * TELEMETRY_SAMPLE_SIZE;
+                b->since = view.seq();
+                reply.insert(reply.end(), payload + TELEMETRY_BATCH_SAMPLES, view.payload + TELEMETRY_SAMPLE_SIZE);
+                reply_ticks.insert(reply_ticks.end(), count, view.timestamp());
+            }
+
+            /* Full batch: more samples may be waiting on that node */
+            if (count == TELEMETRY_BATCH_MAX)
+                turn = waiting - first;
+
+            /* Bus is free: next request before storing this one */
+            waiting = next_address(bus_nodes, first, &turn, mono_ms());
+            if (waiting >= 0) {
+                send_poll(bus.get(), waiting, bus_nodes[waiting - first].since, &stats);
+                sent = mono_ms();
+            }
+        }
+
+        bus->pending = n - pos;
+        memmove(bus->buf, bus->buf + pos, bus->pending);
+
+        /* Older samples of a batch are placed before its reception */
+        now = now_ms();
+        for (pos=0; pos < reply.size(); pos += TELEMETRY_SAMPLE_SIZE) {
+            TelemetryView view;
+
+            view.payload = reply.data() + pos;
+            store_sample(nodes, dir, view, now, reply_ticks[pos / TELEMETRY_SAMPLE_SIZE]);
+            stats.samples++;
+        }
+
+        if (waiting >= 0 && mono_ms() - sent >= timeout_ms) {
+            BusNodeState *b = &bus_nodes[waiting - first];
+            int64_t backoff = (int64_t)GATEWAY_POLL_BACKOFF_MS << (b->misses < 8 ? b->misses : 8);
+
+            if (backoff > GATEWAY_POLL_BACKOFF_MAX_MS)
+                backoff = GATEWAY_POLL_BACKOFF_MAX_MS;
+            b->misses++;
+            b->due = mono_ms() + backoff;
+            stats.timeouts++;
+            waiting = -1;
+        }
+
+        if (mono_ms() - last_sync >= GATEWAY_SYNC_MS) {
+            for (auto &node : nodes)
+                if (node.second.store)
+                    node.second.store->sync();
+            last_sync = mono_ms();
+        }
+    }
+
+    now = mono_ms() - start;
+
+    report_nodes(nodes);
+    fprintf(stderr, "%llu polls, %llu replies, %llu timeouts, %llu samples\n",
+            (unsigned long long)stats.polls, (unsigned long long)stats.replies,
+            (unsigned long long)stats.timeouts, (unsigned long long)stats.samples);
+    if (now > 0)
+        fprintf(stderr, "%.1f polls/s, bus utilization %.1f %% at %d bit/s\n",
+                stats.polls * 1000.0 / now, 100.0 * stats.bytes * 10 * 1000 / now / GATEWAY_LINE_BPS,
+                GATEWAY_LINE_BPS);
+
+    close(bus->fd);
+    if (bus->keep_fd >= 0)
+        close(bus->keep_fd);
+
+    return 0;
+}
+
+static void print_tenths(const char *name, const SeriesStore::Summary &s, int col, const char *unit)
+{
+    printf("%-12s min %7.1f  max %7.1f  mean %7.2f %s\n", name,
+           s.min[col] / 10.0, s.max[col] / 10.0, (double)s.sum[col] / s.count / 10.0, unit);
+}
+
+static int query(const std::string &dir, int argc, char **argv)
+{
+    SeriesStore store;
+    SeriesStore::Summary s;
+    int64_t from = INT64_MIN, to = INT64_MAX;
+    time_t t;
+
+    if (argc < 1)
+        return 2;
+
+    if (argc > 1)
+        from = strtoll(argv[1], NULL, 0) * 1000;
+    if (argc > 2)
+        to = strtoll(argv[2], NULL, 0) * 1000 + 999;
+
+    if (!store.open(dir, atoi(argv[0]), false)) {
+        fprintf(stderr, "no store for node %s in %s\n", argv[0], dir.c_str());
+        return 1;
+    }
+
+    store.query(from, to, &s);
+
+    printf("samples      %llu of %llu\n", (unsigned long long)s.count,
+           (unsigned long long)store.get_count());
+    if (!s.count)
+        return 0;
+
+    t = s.min[SeriesStore::TIME] / 1000;
+    printf("first        %s", ctime(&t));
+    t = s.max[SeriesStore::TIME] / 1000;
+    printf("last         %s", ctime(&t));
+
+    print_tenths("temperature", s, SeriesStore::TEMPERATURE, "oC");
+    print_tenths("humidity", s, SeriesStore::HUMIDITY, "%RH");
+    printf("%-12s min %7lld  max %7lld  mean %7.1f mV\n", "battery",
+           (long long)s.min[SeriesStore::BATTERY], (long long)s.max[SeriesStore::BATTERY],
+           (double)s.sum[SeriesStore::BATTERY] / s.count);
+
+    return 0;
+}
+
+static void print_sample(const int64_t value[SeriesStore::COLUMNS], void *)
+{
+    printf("%lld %lld %lld %lld\n", (long long)value[SeriesStore::TIME],
+           (long long)value[SeriesStore::TEMPERATURE], (long long)value[SeriesStore::HUMIDITY],
+           (long long)value[SeriesStore::BATTERY]);
+}
+
+static int dump(const std::string &dir, int argc, char **argv)
+{
+    SeriesStore store;
+    int64_t from = INT64_MIN, to = INT64_MAX;
+
+    if (argc < 1)
+        return 2;
+
+    if (argc > 1)
+        from = strtoll(argv[1], NULL, 0) * 1000;
+    if (argc > 2)
+        to = strtoll(argv[2], NULL, 0) * 1000 + 999;
+
+    if (!store.open(dir, atoi(argv[0]), false)) {
+        fprintf(stderr, "no store for node %s in %s\n", argv[0], dir.c_str());
+        return 1;
+    }
+
+    store.scan(from, to, print_sample, NULL);
+
+    return 0;
+}
+
+static int usage()
+{
+    fprintf(stderr, "usage: th-gateway ingest <store> <tty|file|--pty>...\n"
+                    "       th-gateway poll <store> <tty|--pty> <first> <last> [timeout ms]\n"
+                    "       th-gateway query <store> <node> [from [to]]\n"
+                    "       th-gateway dump <store> <node> [from [to]]\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    int rc = 2;
+
+    if (argc < 3)
+        return usage();
+
+    if (strcmp(argv[1], "ingest") == 0)
+        rc = ingest(argv[2], argc - 3, argv + 3);
+    else if (strcmp(argv[1], "poll") == 0)
+        rc = poll_bus(argv[2], argc - 3, argv + 3);
+    else if (strcmp(argv[1], "query") == 0)
+        rc = query(argv[2], argc - 3, argv + 3);
+    else if (strcmp(argv[1], "dump") == 0)
+        rc = dump(argv[2], argc - 3, argv + 3);
+
+    return rc == 2 ? usage() : rc;
+}
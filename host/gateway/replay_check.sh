@@ -0,0 +1,79 @@
+#!/bin/sh
+#
+# replay_check.sh : sample times of a replayed fleet capture
+#
+#  Created on: Oct 19, 2026
+#      Author: xtarke
+#
+#      Builds th-fleet and th-gateway, records DURATION seconds of virtual
+#      time of NODES nodes to a capture file, ingests it in one go and
+#      dumps the store of every node. The whole capture is read within a
+#      few ms, so the times must come from the node timestamps: the script
+#      fails unless every node has samples with strictly increasing times
+#      that span about the virtual time recorded.
+#
+#          host/gateway/replay_check.sh
+#
+#      Environment:
+#          CXX        host compiler, default g++
+#          NODES      fleet size, default 5
+#          DURATION   virtual time recorded, default 600
+
+set -e
+
+GATEWAY_DIR=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$GATEWAY_DIR/../.." && pwd)
+CXX=${CXX:-g++}
+NODES=${NODES:-5}
+DURATION=${DURATION:-600}
+OUT=${OUT:-${TMPDIR:-/tmp}/th-replay}
+
+mkdir -p "$OUT"
+rm -rf "$OUT/store" "$OUT/capture.bin"
+
+cd "$ROOT"
+
+$CXX -std=c++14 -O2 -pthread -D__MSP430G2553__ -I host -I CPP \
+    -o "$OUT/th-fleet" host/fleet/fleet.cpp host/Dht22Model.cpp \
+    host/Ssd1306Model.cpp host/msp430_host.cpp host/i2c_host.cpp \
+    host/uart_host.cpp host/timer_delay_host.cpp \
+    host/rs485_host.cpp host/node_config_host.cpp \
+    CPP/ThermoHygrometer.cpp CPP/SSD1306.cpp CPP/MainScreen.cpp \
+    host/clock_host.cpp CPP/Telemetry.cpp CPP/BusNode.cpp \
+    CPP/AdaptiveRate.cpp CPP/LagEstimator.cpp CPP/Comfort.cpp \
+    CPP/SelfHeating.cpp CPP/lib/adc10.c \
+    -x c CPP/lib/telemetry_frame.c CPP/lib/crc.c CPP/lib/format.c
+
+$CXX -std=c++14 -O2 -I CPP -o "$OUT/th-gateway" host/gateway/gateway.cpp \
+    host/gateway/FrameParser.cpp host/gateway/SeriesStore.cpp \
+    host/gateway/MappedFile.cpp -x c CPP/lib/crc.c \
+    CPP/lib/telemetry_frame.c
+
+"$OUT/th-fleet" -n "$NODES" -t "$DURATION" -o "$OUT/capture.bin" > "$OUT/fleet.txt" 2>&1
+"$OUT/th-gateway" ingest "$OUT/store" "$OUT/capture.bin" 2> "$OUT/ingest.txt"
+
+fail=0
+node=1
+while [ "$node" -le "$NODES" ]; do
+    "$OUT/th-gateway" dump "$OUT/store" "$node" | awk -v node="$node" -v seconds="$DURATION" '
+    NR > 1 && $1 <= last {
+        printf "node %d: sample %d at %d ms, previous at %d ms\n", node, NR, $1, last
+        bad = 1
+    }
+    NR == 1 { first = $1 }
+    { last = $1 }
+    END {
+        span = (last - first) / 1000
+        printf "node %d: %d samples over %.1f s\n", node, NR, span
+        if (NR < 2 || span < seconds / 2 || span > seconds * 1.5)
+            bad = 1
+        exit bad
+    }' || fail=1
+    node=$((node + 1))
+done
+
+if [ "$fail" -ne 0 ]; then
+    echo "FAIL"
+    exit 1
+fi
+echo "PASS"
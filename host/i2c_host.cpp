@@ -0,0 +1,158 @@
+/*
+ * i2c_host.cpp : host implementation of lib/i2c_master_f247_g2xxx
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <msp430.h>
+#include <string.h>
+
+#include <lib/i2c_master_f247_g2xxx.h>
+#include "I2cSlave.h"
+
+/* 100kHz SCL at 16MHz MCLK: 9 clocks per byte */
+#define HOST_I2C_CYCLES_PER_BYTE    (9 * 160)
+
+/* NACKs are counted per context, the host bus never times out */
+static thread_local i2c_stats_t i2c_stats;
+
+void host_i2c_attach(I2cSlave *slave)
+{
+    slave->next = (I2cSlave *)host_mcu->i2c_slaves;
+    host_mcu->i2c_slaves = slave;
+}
+
+static I2cSlave *find_slave(uint8_t dev_addr)
+{
+    I2cSlave *slave = (I2cSlave *)host_mcu->i2c_slaves;
+
+    while (slave && slave->address != dev_addr)
+        slave = slave->next;
+
+    return slave;
+}
+
+/* Start, address byte and stop */
+static void bus_time(uint16_t bytes)
+{
+    /* Queued writes go first */
+    i2c_flush();
+    host_mcu->cycles += (uint64_t)(bytes + 1) * HOST_I2C_CYCLES_PER_BYTE;
+}
+
+void init_i2c_master_mode()
+{
+}
+
+i2c_mode i2c_master_read_reg(uint8_t dev_addr, uint8_t reg_addr, uint8_t count, uint8_t *data)
+{
+    I2cSlave *slave = find_slave(dev_addr);
+
+    bus_time(1);
+    if (!slave || !slave->write(&reg_addr, 1)) {
+        host_mcu->i2c_nack++;
+        return NACK_MODE;
+    }
+
+    bus_time(count);
+    if (!slave->read(data, count)) {
+        host_mcu->i2c_nack++;
+        return NACK_MODE;
+    }
+
+    return IDLE_MODE;
+}
+
+i2c_mode i2c_master_read(uint8_t dev_addr, uint8_t count, uint8_t *data)
+{
+    I2cSlave *slave = find_slave(dev_addr);
+
+    bus_time(count);
+    if (!slave || !slave->read(data, count)) {
+        host_mcu->i2c_nack++;
+        return NACK_MODE;
+    }
+
+    return IDLE_MODE;
+}
+
+i2c_mode i2c_write_single_byte(uint8_t dev_addr, uint8_t byte)
+{
+    return i2c_master_write_reg(dev_addr, byte, NULL, 0);
+}
+
+i2c_mode i2c_master_write_reg(uint8_t dev_addr, uint8_t reg_addr, uint8_t *reg_data, uint8_t count)
+{
+    I2cSlave *slave = find_slave(dev_addr);
+    uint8_t buffer[256];
+
+    buffer[0] = reg_addr;
+    if (count)
+        memcpy(buffer + 1, reg_data, count);
+
+    bus_time(count + 1);
+    if (!slave || !slave->write(buffer, count + 1)) {
+        host_mcu->i2c_nack++;
+        return NACK_MODE;
+    }
+
+    return IDLE_MODE;
+}
+
+/* The slave gets the data at once; the bus is busy for its time from
+ * the end of the previous queued write, while the CPU goes on */
+void i2c_queue_write(i2c_transaction_t *t)
+{
+    I2cSlave *slave = find_slave(t->dev_addr);
+    uint8_t buffer[256];
+    uint64_t start = host_mcu->i2c_queue_end > host_mcu->cycles ?
+                     host_mcu->i2c_queue_end : host_mcu->cycles;
+
+    buffer[0] = t->reg_addr;
+    if (t->count)
+        memcpy(buffer + 1, t->data, t->count);
+
+    t->next = NULL;
+    host_mcu->i2c_queue_end = start + (uint64_t)(t->count + 2) * HOST_I2C_CYCLES_PER_BYTE;
+    if (!slave || !slave->write(buffer, t->count + 1)) {
+        host_mcu->i2c_nack++;
+        t->state = NACK_MODE;
+    }
+    else
+        t->state = IDLE_MODE;
+}
+
+uint8_t i2c_queue_done(const i2c_transaction_t *t)
+{
+    return t->state != TX_REG_ADDRESS_MODE;
+}
+
+uint8_t i2c_queue_busy()
+{
+    return host_mcu->cycles < host_mcu->i2c_queue_end;
+}
+
+/* Awake until the queue is empty, as the blocking transfers */
+void i2c_flush()
+{
+    if (host_mcu->cycles < host_mcu->i2c_queue_end)
+        host_mcu->cycles = host_mcu->i2c_queue_end;
+}
+
+void i2c_bus_recovery()
+{
+    i2c_stats.recovery++;
+}
+
+const i2c_stats_t *i2c_get_stats()
+{
+    i2c_stats.nack = host_mcu->i2c_nack;
+
+    return &i2c_stats;
+}
+
+void CopyArray(uint8_t *source, uint8_t *dest, uint8_t count)
+{
+    memcpy(dest, source, count);
+}
@@ -0,0 +1,258 @@
+/*
+ * msp430.h : host (Linux) stand-in for the TI device header
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Lets the firmware classes build with g++ on a PC: put this
+ *      directory before the CPP directory in the include path.
+ *
+ *          g++ -std=c++14 -I host -I CPP ...
+ *
+ *      Registers live in a host_mcu_t context selected per thread, so
+ *      several firmware instances can run side by side. Accesses to PxIN,
+ *      PxOUT and PxDIR call the port hook, letting a model see the pins
+ *      and drive them against the virtual MCLK cycle counter. Entering a low power mode calls the
+ *      sleep hook, which advances time and runs the ISRs. Interrupt
+ *      service routines compile to ordinary functions.
+ *
+ *      The counter always runs at HOST_MCLK_MHZ. When the firmware lowers
+ *      MCLK (lib/clock.h, clock_host.cpp) a CPU cycle advances it by
+ *      HOST_MCLK_MHZ / MHz, and the time spent at each clock is kept for
+ *      energy estimates.
+ */
+
+#ifndef HOST_MSP430_H_
+#define HOST_MSP430_H_
+
+#include <stdint.h>
+
+#define BIT0                (0x0001)
+#define BIT1                (0x0002)
+#define BIT2                (0x0004)
+#define BIT3                (0x0008)
+#define BIT4                (0x0010)
+#define BIT5                (0x0020)
+#define BIT6                (0x0040)
+#define BIT7                (0x0080)
+#define BIT8                (0x0100)
+#define BIT9                (0x0200)
+#define BITA                (0x0400)
+#define BITB                (0x0800)
+#define BITC                (0x1000)
+#define BITD                (0x2000)
+#define BITE                (0x4000)
+#define BITF                (0x8000)
+
+/* Status register */
+#define GIE                 (0x0008)
+#define CPUOFF              (0x0010)
+#define OSCOFF              (0x0020)
+#define SCG0                (0x0040)
+#define SCG1                (0x0080)
+
+#define LPM0_bits           (CPUOFF)
+#define LPM1_bits           (SCG0 + CPUOFF)
+#define LPM2_bits           (SCG1 + CPUOFF)
+#define LPM3_bits           (SCG1 + SCG0 + CPUOFF)
+#define LPM4_bits           (SCG1 + SCG0 + OSCOFF + CPUOFF)
+
+/* Interrupt vectors: only used as attribute arguments */
+#define PORT1_VECTOR        (2 * 2u)
+#define PORT2_VECTOR        (3 * 2u)
+#define ADC10_VECTOR        (5 * 2u)
+#define USCIAB0TX_VECTOR    (6 * 2u)
+#define USCIAB0RX_VECTOR    (7 * 2u)
+#define TIMER0_A1_VECTOR    (8 * 2u)
+#define TIMER0_A0_VECTOR    (9 * 2u)
+#define WDT_VECTOR          (10 * 2u)
+#define TIMER1_A1_VECTOR    (12 * 2u)
+#define TIMER1_A0_VECTOR    (13 * 2u)
+
+/* Watchdog */
+#define WDTIS0              (0x0001)
+#define WDTIS1              (0x0002)
+#define WDTSSEL             (0x0004)
+#define WDTCNTCL            (0x0008)
+#define WDTTMSEL            (0x0010)
+#define WDTHOLD             (0x0080)
+#define WDTPW               (0x5A00)
+#define WDT_ADLY_1000       (WDTPW+WDTTMSEL+WDTCNTCL+WDTSSEL)
+#define WDT_ADLY_250        (WDTPW+WDTTMSEL+WDTCNTCL+WDTSSEL+WDTIS0)
+#define WDT_ADLY_16         (WDTPW+WDTTMSEL+WDTCNTCL+WDTSSEL+WDTIS1)
+#define WDT_ADLY_1_9        (WDTPW+WDTTMSEL+WDTCNTCL+WDTSSEL+WDTIS1+WDTIS0)
+#define WDTIE               (0x01)
+#define WDTIFG              (0x01)
+
+/* Basic clock system */
+#define LFXT1S_2            (0x20)
+#define DIVS_0              (0x00)
+#define DIVS_3              (0x06)
+
+/* ADC10 */
+#define ADC10SC             (0x001)
+#define ENC                 (0x002)
+#define ADC10IFG            (0x004)
+#define ADC10IE             (0x008)
+#define ADC10ON             (0x010)
+#define REFON               (0x020)
+#define REF2_5V             (0x040)
+#define SREF_0              (0 * 0x2000u)
+#define SREF_1              (1 * 0x2000u)
+#define ADC10SHT_0          (0 * 0x800u)
+#define ADC10SHT_1          (1 * 0x800u)
+#define ADC10SHT_2          (2 * 0x800u)
+#define ADC10SHT_3          (3 * 0x800u)
+#define ADC10BUSY           (0x0001)
+#define ADC10DIV_0          (0 * 0x20u)
+#define ADC10DIV_3          (3 * 0x20u)
+#define INCH_0              (0 * 0x1000u)
+#define INCH_1              (1 * 0x1000u)
+#define INCH_10             (10 * 0x1000u)
+#define INCH_11             (11 * 0x1000u)
+
+/* Time base of the cycle counter: F_CPU of the host builds */
+#define HOST_MCLK_MHZ       16
+
+typedef struct host_mcu {
+    /* GPIO, indexed by port number */
+    uint8_t port_in[3];
+    uint8_t port_out[3];
+    uint8_t port_dir[3];
+    uint8_t port_ren[3];
+    uint8_t port_sel[3];
+    uint8_t port_sel2[3];
+    uint8_t port_ie[3];
+    uint8_t port_ies[3];
+    uint8_t port_ifg[3];
+
+    /* ADC10 */
+    uint16_t adc10ctl0;
+    uint16_t adc10ctl1;
+    uint16_t adc10mem;
+    uint8_t adc10ae0;
+
+    /* Watchdog, special function and clock registers */
+    uint16_t wdtctl;
+    uint8_t ie1;
+    uint8_t ifg1;
+    uint8_t dcoctl;
+    uint8_t bcsctl1;
+    uint8_t bcsctl2;
+    uint8_t bcsctl3;
+
+    /* USCI_A0 received byte (rs485_host.cpp) and link state */
+    uint8_t uca0rxbuf;
+    void *rs485;
+
+    /* Information memory segment D (0x1000) */
+    uint8_t info_d[64];
+
+    /* Status register and virtual MCLK cycle counter */
+    uint16_t sr;
+    uint64_t cycles;
+
+    /* MCLK in MHz, 0: HOST_MCLK_MHZ. Counter value at the last change
+     * and time spent at each MCLK, indexed by MHz (host_mclk_account) */
+    uint8_t mclk_mhz;
+    uint64_t mclk_since;
+    uint64_t mclk_cycles[HOST_MCLK_MHZ + 1];
+
+    /* Devices of the I2C bus: list of I2cSlave (i2c_host.cpp) */
+    void *i2c_slaves;
+    uint16_t i2c_nack;
+    /* Counter value when the queued I2C writes are all sent */
+    uint64_t i2c_queue_end;
+
+    /* Called before every access to PxIN, PxOUT or PxDIR: pins are
+     * constant between two calls */
+    void (*port_hook)(struct host_mcu *mcu, uint8_t port);
+    /* Called while the CPU is off: must advance time and run ISRs */
+    void (*sleep_hook)(struct host_mcu *mcu);
+    /* Bytes sent by the UART (uart_host.cpp) */
+    void (*uart_tx_hook)(struct host_mcu *mcu, const uint8_t *data, uint8_t count);
+    /* Model state owned by the user of this context */
+    void *user;
+} host_mcu_t;
+
+/* Context of the firmware instance running in the calling thread */
+extern thread_local host_mcu_t *host_mcu;
+
+volatile uint8_t *host_port(uint8_t *reg, uint8_t port);
+void host_sleep(uint16_t bits);
+void host_mclk_account(host_mcu_t *mcu);
+
+/* CPU cycles at the current MCLK -> counter cycles */
+static inline void host_cpu_cycles(uint64_t cycles)
+{
+    if (host_mcu->mclk_mhz)
+        cycles = cycles * HOST_MCLK_MHZ / host_mcu->mclk_mhz;
+    host_mcu->cycles += cycles;
+}
+
+/* Calibration data is never erased on host */
+#define CALBC1_1MHZ         (0x86)
+#define CALDCO_1MHZ         (0xB5)
+#define CALBC1_8MHZ         (0x8D)
+#define CALDCO_8MHZ         (0x92)
+#define CALBC1_12MHZ        (0x8E)
+#define CALDCO_12MHZ        (0x9E)
+#define CALBC1_16MHZ        (0x8F)
+#define CALDCO_16MHZ        (0x95)
+
+/* Temperature sensor calibration of the TLV (lib/adc10.c): typical
+ * readings at 30 and 85oC with the 1.5V reference */
+#define ADC10_CAL_15T30     (745)
+#define ADC10_CAL_15T85     (878)
+
+/* Registers */
+#define P1IN                (*host_port(host_mcu->port_in, 1))
+#define P1OUT               (*host_port(host_mcu->port_out, 1))
+#define P1DIR               (*host_port(host_mcu->port_dir, 1))
+#define P1REN               (host_mcu->port_ren[1])
+#define P1SEL               (host_mcu->port_sel[1])
+#define P1SEL2              (host_mcu->port_sel2[1])
+#define P1IE                (host_mcu->port_ie[1])
+#define P1IES               (host_mcu->port_ies[1])
+#define P1IFG               (host_mcu->port_ifg[1])
+
+#define P2IN                (*host_port(host_mcu->port_in, 2))
+#define P2OUT               (*host_port(host_mcu->port_out, 2))
+#define P2DIR               (*host_port(host_mcu->port_dir, 2))
+#define P2REN               (host_mcu->port_ren[2])
+#define P2SEL               (host_mcu->port_sel[2])
+#define P2SEL2              (host_mcu->port_sel2[2])
+#define P2IE                (host_mcu->port_ie[2])
+#define P2IES               (host_mcu->port_ies[2])
+#define P2IFG               (host_mcu->port_ifg[2])
+
+#define ADC10CTL0           (host_mcu->adc10ctl0)
+#define ADC10CTL1           (host_mcu->adc10ctl1)
+#define ADC10MEM            (host_mcu->adc10mem)
+#define ADC10AE0            (host_mcu->adc10ae0)
+
+#define WDTCTL              (host_mcu->wdtctl)
+#define IE1                 (host_mcu->ie1)
+#define IFG1                (host_mcu->ifg1)
+#define DCOCTL              (host_mcu->dcoctl)
+#define BCSCTL1             (host_mcu->bcsctl1)
+#define BCSCTL2             (host_mcu->bcsctl2)
+#define BCSCTL3             (host_mcu->bcsctl3)
+
+#define UCA0RXBUF           (host_mcu->uca0rxbuf)
+
+/* Intrinsics */
+#define __delay_cycles(x)               host_cpu_cycles(x)
+#define __no_operation()                ((void)0)
+#define __bis_SR_register(x)            host_sleep(x)
+#define __bic_SR_register(x)            (host_mcu->sr &= ~(x))
+#define __bic_SR_register_on_exit(x)    (host_mcu->sr &= ~(x))
+#define __bis_SR_register_on_exit(x)    (host_mcu->sr |= (x))
+#define __get_SR_register()             (host_mcu->sr)
+#define __enable_interrupt()            (host_mcu->sr |= GIE)
+#define __disable_interrupt()           (host_mcu->sr &= ~GIE)
+
+/* __attribute__((interrupt(VECTOR))) -> plain function callable by models */
+#define interrupt(vector)               used
+
+#endif /* HOST_MSP430_H_ */
@@ -0,0 +1,69 @@
+/*
+ * msp430_host.cpp : host register context and low power mode emulation
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <msp430.h>
+
+/* Context used by threads that never select one */
+static host_mcu_t default_mcu;
+
+thread_local host_mcu_t *host_mcu = &default_mcu;
+
+/**
+ * @brief  Access PxIN, PxOUT or PxDIR: lets the pin models see the
+ *         state before the access and update the inputs. Every access
+ *         costs a few virtual cycles so polling loops make progress
+ *         in time.
+ * @param  reg: register array of the context (port_in, port_out...).
+ *         port: port number.
+ *
+ * @retval Pointer to the register.
+ */
+volatile uint8_t *host_port(uint8_t *reg, uint8_t port)
+{
+    host_cpu_cycles(3);
+
+    if (host_mcu->port_hook)
+        host_mcu->port_hook(host_mcu, port);
+
+    return &reg[port];
+}
+
+/**
+ * @brief  __bis_SR_register(): set status register bits and, when the
+ *         CPU is turned off, stay in the sleep hook until an ISR clears
+ *         CPUOFF. Without a hook the CPU wakes up immediately.
+ * @param  bits: status register bits.
+ *
+ * @retval Nenhum.
+ */
+void host_sleep(uint16_t bits)
+{
+    host_mcu->sr |= bits;
+
+    while (host_mcu->sr & CPUOFF) {
+        if (!host_mcu->sleep_hook) {
+            host_mcu->sr &= ~LPM4_bits;
+            break;
+        }
+        host_mcu->sleep_hook(host_mcu);
+    }
+}
+
+/**
+ * @brief  Add the time since the last MCLK change to the current MCLK.
+ *         Call before changing mclk_mhz and before reading mclk_cycles.
+ * @param  mcu: context.
+ *
+ * @retval Nenhum.
+ */
+void host_mclk_account(host_mcu_t *mcu)
+{
+    uint8_t mhz = mcu->mclk_mhz ? mcu->mclk_mhz : HOST_MCLK_MHZ;
+
+    mcu->mclk_cycles[mhz] += mcu->cycles - mcu->mclk_since;
+    mcu->mclk_since = mcu->cycles;
+}
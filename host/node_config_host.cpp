@@ -0,0 +1,25 @@
+/*
+ * node_config_host.cpp : host implementation of lib/node_config
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Information memory segment D is host_mcu->info_d.
+ */
+
+#include <msp430.h>
+#include <string.h>
+
+#include <lib/node_config.h>
+
+uint16_t node_config_address(uint16_t default_address)
+{
+    node_config_t config;
+
+    memcpy(&config, host_mcu->info_d, sizeof(config));
+
+    if (config.magic != NODE_CONFIG_MAGIC)
+        return default_address;
+
+    return config.address;
+}
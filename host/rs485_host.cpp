@@ -0,0 +1,75 @@
+/*
+ * rs485_host.cpp : host implementation of lib/rs485
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Same frame assembly and address filter as the device; the state
+ *      belongs to the context. A bus model writes each byte to UCA0RXBUF
+ *      of every node and calls rs485_rx_isr() in that node's context.
+ *      Transmitted frames go to the UART hook.
+ */
+
+#include <msp430.h>
+#include <string.h>
+
+#include <lib/rs485.h>
+#include <lib/telemetry_frame.h>
+
+struct HostRs485 {
+    telemetry_rx_t rx;
+    uint8_t ready;
+    uint16_t address;
+};
+
+static HostRs485 *link()
+{
+    return (HostRs485 *)host_mcu->rs485;
+}
+
+void init_rs485(uint16_t address)
+{
+    if (!host_mcu->rs485)
+        host_mcu->rs485 = new HostRs485;
+
+    memset(link(), 0, sizeof(HostRs485));
+    link()->address = address;
+}
+
+const uint8_t *rs485_request()
+{
+    return link() && link()->ready ? link()->rx.buf : NULL;
+}
+
+void rs485_release()
+{
+    link()->rx.count = 0;
+    link()->ready = 0;
+}
+
+void rs485_send(const uint8_t *frame, uint8_t size)
+{
+    uart_write(frame, size);
+}
+
+uint8_t rs485_rx_isr()
+{
+    HostRs485 *bus = link();
+    uint16_t node;
+
+    if (!bus || bus->ready || !telemetry_rx_byte(&bus->rx, UCA0RXBUF))
+        return 0;
+
+    if (bus->rx.buf[3] != TELEMETRY_TYPE_POLL || bus->rx.buf[2] != TELEMETRY_POLL_SIZE)
+        return 0;
+
+    node = bus->rx.buf[TELEMETRY_HEADER_SIZE + TELEMETRY_POLL_NODE] |
+           bus->rx.buf[TELEMETRY_HEADER_SIZE + TELEMETRY_POLL_NODE + 1] << 8;
+
+    if (node != bus->address)
+        return 0;
+
+    bus->ready = 1;
+
+    return 1;
+}
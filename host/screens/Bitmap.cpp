@@ -0,0 +1,211 @@
+/*
+ * Bitmap.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ */
+
+#include <stdio.h>
+
+#include "Bitmap.h"
+
+Bitmap Bitmap::from_pages(const uint8_t *pages, unsigned width, unsigned page_count)
+{
+    Bitmap image(width, page_count * 8);
+    unsigned x, y;
+
+    for (y=0; y < image.height; y++)
+        for (x=0; x < width; x++)
+            image.set(x, y, (pages[(y / 8) * width + x] >> (y % 8)) & 1);
+
+    return image;
+}
+
+/* PBM header field: skips white space and comments */
+static bool pbm_field(FILE *f, unsigned *value)
+{
+    int c;
+
+    do {
+        c = fgetc(f);
+        if (c == '#')
+            while (c != '\n' && c != EOF)
+                c = fgetc(f);
+    } while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+
+    if (c < '0' || c > '9')
+        return false;
+
+    *value = 0;
+    while (c >= '0' && c <= '9') {
+        *value = *value * 10 + (c - '0');
+        c = fgetc(f);
+    }
+
+    /* One white space character ends the field */
+    return c != EOF;
+}
+
+bool Bitmap::load_pbm(const std::string &path)
+{
+    FILE *f = fopen(path.c_str(), "rb");
+    std::vector<uint8_t> row;
+    unsigned x, y;
+    bool ok;
+
+    if (!f)
+        return false;
+
+    ok = fgetc(f) == 'P' && fgetc(f) == '4' && pbm_field(f, &width) && pbm_field(f, &height) &&
+         width && height && width <= 4096 && height <= 4096;
+
+    if (ok) {
+        pixels.assign(width * height, 0);
+        row.resize((width + 7) / 8);
+
+        for (y=0; ok && y < height; y++) {
+            ok = fread(row.data(), 1, row.size(), f) == row.size();
+            for (x=0; ok && x < width; x++)
+                set(x, y, !((row[x / 8] >> (7 - x % 8)) & 1));
+        }
+    }
+
+    fclose(f);
+
+    return ok;
+}
+
+bool Bitmap::save_pbm(const std::string &path) const
+{
+    FILE *f = fopen(path.c_str(), "wb");
+    std::vector<uint8_t> row((width + 7) / 8);
+    unsigned x, y;
+    bool ok;
+
+    if (!f)
+        return false;
+
+    ok = fprintf(f, "P4\n%u %u\n", width, height) > 0;
+
+    for (y=0; ok && y < height; y++) {
+        for (x=0; x < row.size(); x++)
+            row[x] = 0;
+        for (x=0; x < width; x++)
+            if (!get(x, y))
+                row[x / 8] |= 0x80 >> (x % 8);
+        ok = fwrite(row.data(), 1, row.size(), f) == row.size();
+    }
+
+    return fclose(f) == 0 && ok;
+}
+
+static uint32_t png_crc(const uint8_t *data, size_t size, uint32_t crc = 0xFFFFFFFF)
+{
+    size_t i;
+    int k;
+
+    for (i=0; i < size; i++) {
+        crc ^= data[i];
+        for (k=0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+
+    return crc;
+}
+
+static void put_u32(std::vector<uint8_t> &out, uint32_t value)
+{
+    out.push_back(value >> 24);
+    out.push_back(value >> 16);
+    out.push_back(value >> 8);
+    out.push_back(value);
+}
+
+static void png_chunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data)
+{
+    size_t start;
+
+    put_u32(out, data.size());
+    start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    put_u32(out, ~png_crc(out.data() + start, out.size() - start));
+}
+
+bool Bitmap::save_png(const std::string &path) const
+{
+    std::vector<uint8_t> png, header, raw, zlib;
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    size_t row = (width + 7) / 8;
+    uint32_t a = 1, b = 0;
+    size_t i, n;
+    unsigned x, y;
+    FILE *f;
+
+    /* Scanlines: filter type 0, 1 bit gray, lit pixels white */
+    for (y=0; y < height; y++) {
+        raw.push_back(0);
+        raw.resize(raw.size() + row, 0);
+        for (x=0; x < width; x++)
+            if (get(x, y))
+                raw[raw.size() - row + x / 8] |= 0x80 >> (x % 8);
+    }
+
+    /* zlib stream of stored blocks */
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    i = 0;
+    do {
+        n = raw.size() - i > 65535 ? 65535 : raw.size() - i;
+        zlib.push_back(i + n == raw.size());    /* BFINAL, BTYPE 00 */
+        zlib.push_back(n);
+        zlib.push_back(n >> 8);
+        zlib.push_back(~n);
+        zlib.push_back(~n >> 8);
+        zlib.insert(zlib.end(), raw.begin() + i, raw.begin() + i + n);
+        i += n;
+    } while (i < raw.size());
+    for (i=0; i < raw.size(); i++) {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    put_u32(zlib, b << 16 | a);
+
+    put_u32(header, width);
+    put_u32(header, height);
+    header.push_back(1);    /* bit depth */
+    header.push_back(0);    /* grayscale */
+    header.push_back(0);    /* deflate */
+    header.push_back(0);    /* adaptive filtering */
+    header.push_back(0);    /* no interlace */
+
+    png.insert(png.end(), signature, signature + 8);
+    png_chunk(png, "IHDR", header);
+    png_chunk(png, "IDAT", zlib);
+    png_chunk(png, "IEND", std::vector<uint8_t>());
+
+    f = fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+
+    n = fwrite(png.data(), 1, png.size(), f);
+
+    return fclose(f) == 0 && n == png.size();
+}
+
+long Bitmap::diff(const Bitmap &other, Bitmap *result) const
+{
+    long count = 0;
+    size_t i;
+
+    if (width != other.width || height != other.height)
+        return -1;
+
+    *result = Bitmap(width, height);
+    for (i=0; i < pixels.size(); i++) {
+        result->pixels[i] = pixels[i] != other.pixels[i];
+        count += result->pixels[i];
+    }
+
+    return count;
+}
@@ -0,0 +1,43 @@
+/*
+ * Bitmap.h : 1 bit images for display dumps
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      One byte per pixel in memory, 1 lit. Saved as binary PBM (P4),
+ *      where lit OLED pixels are white (0) on black (1), or as a 1 bit
+ *      grayscale PNG with stored deflate blocks: no zlib needed.
+ */
+
+#ifndef HOST_SCREENS_BITMAP_H_
+#define HOST_SCREENS_BITMAP_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class Bitmap
+{
+public:
+    Bitmap() : width(0), height(0) {}
+    Bitmap(unsigned w, unsigned h) : width(w), height(h), pixels(w * h, 0) {}
+
+    /* SSD1306 pages: bytes of 8 vertical pixels, LSB on top */
+    static Bitmap from_pages(const uint8_t *pages, unsigned width, unsigned page_count);
+
+    uint8_t get(unsigned x, unsigned y) const { return pixels[y * width + x]; }
+    void set(unsigned x, unsigned y, uint8_t lit) { pixels[y * width + x] = lit; }
+
+    bool load_pbm(const std::string &path);
+    bool save_pbm(const std::string &path) const;
+    bool save_png(const std::string &path) const;
+
+    /* Pixels that differ: lit in the result. -1 when sizes differ */
+    long diff(const Bitmap &other, Bitmap *result) const;
+
+    unsigned width;
+    unsigned height;
+    std::vector<uint8_t> pixels;
+};
+
+#endif /* HOST_SCREENS_BITMAP_H_ */
@@ -0,0 +1,292 @@
+/*
+ * screens.cpp : display dumps and golden image comparison
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      g++ -std=c++14 -O2 -D__MSP430G2553__ -I host -I CPP -o th-screens \
+ *          host/screens/screens.cpp host/screens/Bitmap.cpp \
+ *          host/Ssd1306Model.cpp host/i2c_host.cpp host/msp430_host.cpp \
+ *          CPP/SSD1306.cpp CPP/MainScreen.cpp -x c CPP/lib/format.c
+ *
+ *      Use -D__MSP430F247__ for the 1KB frame buffer of the F247; keep
+ *      golden images of each device in its own directory.
+ *
+ *      th-screens list
+ *      th-screens dump <dir> [--png]
+ *          Draws every screen case with the CPP SSD1306 class and writes
+ *          what reached the display:
+ *              <case>.pbm          display RAM, 128x64
+ *              <case>.band<n>.pbm  data of the n-th Refresh(): one band
+ *                                  of the frame buffer (128x16 on G2553,
+ *                                  the whole 128x64 buffer on F247), or
+ *                                  the pages sent by Flush() on F247
+ *      th-screens compare <golden dir> [--out dir]
+ *          Draws the cases again and compares them with the golden PBMs,
+ *          pixel by pixel. With --out, the images that differ are written
+ *          there with a .diff.pbm of the changed pixels. Exit status 1 if
+ *          any image differs or is missing.
+ *
+ *      Golden images are made with dump from a build whose output was
+ *      checked by eye, before a change to the draw path. Those of each
+ *      device are kept in host/screens/golden:
+ *
+ *          th-screens compare host/screens/golden/g2553    (G2553 build)
+ *          th-screens compare host/screens/golden/f247     (F247 build)
+ *
+ *      A change that is meant to alter a screen dumps over them and
+ *      commits the new images with it.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
+
+#include <msp430.h>
+
+#include "SSD1306.h"
+#include "MainScreen.h"
+#include "Ssd1306Model.h"
+#include "Bitmap.h"
+
+#define SCREENS_OLED_ADDRESS    0x3C
+
+/* Display model that also keeps the data of each Refresh() */
+class BandRecorder: public Ssd1306Model
+{
+public:
+    BandRecorder(uint8_t addr) : Ssd1306Model(addr), in_data(false) {}
+
+    bool write(const uint8_t *data, uint8_t count)
+    {
+        if (count && (data[0] & 0x40)) {
+            if (!in_data)
+                bands.push_back(std::vector<uint8_t>());
+            bands.back().insert(bands.back().end(), data + 1, data + count);
+            in_data = true;
+        }
+        else
+            in_data = false;
+
+        return Ssd1306Model::write(data, count);
+    }
+
+    std::vector<std::vector<uint8_t>> bands;
+
+private:
+    bool in_data;
+};
+
+struct ScreenCase {
+    const char *name;
+    const char *description;
+    void (*draw)(SSD1306 &oled, MainScreen &screen);
+};
+
+static const ScreenCase cases[] = {
+    { "main_standard", "23.5 oC, 55.1 %RH, 3.3 V",
+      [](SSD1306 &, MainScreen &screen) { screen.show(235, 551, 33); } },
+    { "main_zero", "failed sensor read: zeros",
+      [](SSD1306 &, MainScreen &screen) { screen.show(0, 0, 0); } },
+    { "main_max", "largest three digit values",
+      [](SSD1306 &, MainScreen &screen) { screen.show(999, 999, 99); } },
+    { "main_humidity_100", "100.0 %RH: four digits",
+      [](SSD1306 &, MainScreen &screen) { screen.show(235, 1000, 33); } },
+    { "main_battery_low", "2.8 V battery",
+      [](SSD1306 &, MainScreen &screen) { screen.show(235, 551, 28); } },
+    { "main_humidity_estimated", "projected humidity: h~",
+      [](SSD1306 &, MainScreen &screen) { screen.show(235, 551, 33, 1); } },
+    { "main_below_zero", "-5.3 oC: sign in the leading digit",
+      [](SSD1306 &, MainScreen &screen) { screen.show(-53, 551, 33); } },
+    { "main_below_minus_ten", "-12.3 oC: sign in place of the colon",
+      [](SSD1306 &, MainScreen &screen) { screen.show(-123, 551, 33); } },
+    { "comfort_absolute", "dew point 13.9 oC, 11.5 g/m3",
+      [](SSD1306 &, MainScreen &screen) { screen.show_comfort(139, 115, 0); } },
+    { "comfort_heat_index", "dew point 23.9 oC, heat index 37.2 oC",
+      [](SSD1306 &, MainScreen &screen) { screen.show_comfort(239, 372, 1); } },
+    { "comfort_frost", "dew point -12.3 oC, 2.1 g/m3",
+      [](SSD1306 &, MainScreen &screen) { screen.show_comfort(-123, 21, 0); } },
+    { "char_clip_right", "scale 2 character past the right edge",
+      [](SSD1306 &oled, MainScreen &) {
+          oled.ClearFrameBuffer();
+          oled.WriteScaledChar(120, 0, 'W', 2);
+          oled.Refresh(SSD1306::LINE_1);
+      } },
+    { "line_band", "diagonals across a band",
+      [](SSD1306 &oled, MainScreen &) {
+          oled.ClearFrameBuffer();
+          oled.WriteLine(0, 0, 127, 15, SSD1306::WHITE_PIXEL);
+          oled.WriteLine(0, 15, 127, 0, SSD1306::WHITE_PIXEL);
+          oled.Refresh(SSD1306::LINE_2);
+      } },
+    { "fill_band", "filled band with a cleared rectangle",
+      [](SSD1306 &oled, MainScreen &) {
+          oled.ClearFrameBuffer();
+          oled.FillRect(0, 0, 128, 16, SSD1306::WHITE_PIXEL);
+          oled.FillRect(40, 4, 48, 8, SSD1306::BLACK_PIXEL);
+          oled.Refresh(SSD1306::LINE_3);
+      } },
+};
+
+#define SCREEN_CASES    (sizeof(cases) / sizeof(cases[0]))
+
+/* Named images of one case */
+struct Rendered {
+    std::vector<std::string> names;
+    std::vector<Bitmap> images;
+};
+
+static Rendered render(const ScreenCase &c)
+{
+    host_mcu_t mcu;
+    BandRecorder display(SCREENS_OLED_ADDRESS);
+    Rendered out;
+    size_t n;
+
+    memset(&mcu, 0, sizeof(mcu));
+    host_mcu = &mcu;
+    host_i2c_attach(&display);
+
+    {
+        SSD1306 oled(SCREENS_OLED_ADDRESS);
+        MainScreen screen(oled);
+
+        oled.Init();
+        c.draw(oled, screen);
+        screen.send();
+        i2c_flush();
+    }
+
+    out.names.push_back(std::string(c.name) + ".pbm");
+    out.images.push_back(Bitmap::from_pages(&display.gddram[0][0], SSD1306_MODEL_WIDTH, SSD1306_MODEL_PAGES));
+
+    for (n=0; n < display.bands.size(); n++) {
+        const std::vector<uint8_t> &band = display.bands[n];
+
+        out.names.push_back(std::string(c.name) + ".band" + std::to_string(n) + ".pbm");
+        out.images.push_back(Bitmap::from_pages(band.data(), SSD1306_MODEL_WIDTH,
+                                                band.size() / SSD1306_MODEL_WIDTH));
+    }
+
+    return out;
+}
+
+static bool make_dir(const std::string &dir)
+{
+    if (mkdir(dir.c_str(), 0755) < 0 && errno != EEXIST) {
+        perror(dir.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+static int dump(const std::string &dir, bool png)
+{
+    size_t i, k;
+
+    if (!make_dir(dir))
+        return 1;
+
+    for (i=0; i < SCREEN_CASES; i++) {
+        Rendered r = render(cases[i]);
+
+        for (k=0; k < r.images.size(); k++) {
+            std::string path = dir + "/" + r.names[k];
+
+            if (!r.images[k].save_pbm(path) ||
+                (png && !r.images[k].save_png(path.substr(0, path.size() - 4) + ".png"))) {
+                perror(path.c_str());
+                return 1;
+            }
+        }
+        printf("%-20s %zu images\n", cases[i].name, r.images.size());
+    }
+
+    return 0;
+}
+
+static int compare(const std::string &golden, const char *out)
+{
+    unsigned failed = 0, checked = 0;
+    size_t i, k;
+
+    if (out && !make_dir(out))
+        return 1;
+
+    for (i=0; i < SCREEN_CASES; i++) {
+        Rendered r = render(cases[i]);
+
+        for (k=0; k < r.images.size(); k++) {
+            Bitmap expected, changed;
+            long pixels;
+
+            checked++;
+
+            if (!expected.load_pbm(golden + "/" + r.names[k])) {
+                printf("%-28s missing golden image\n", r.names[k].c_str());
+                failed++;
+                continue;
+            }
+
+            pixels = r.images[k].diff(expected, &changed);
+            if (!pixels)
+                continue;
+
+            failed++;
+            if (pixels < 0)
+                printf("%-28s size %ux%u, golden %ux%u\n", r.names[k].c_str(), r.images[k].width,
+                       r.images[k].height, expected.width, expected.height);
+            else
+                printf("%-28s %ld pixels differ\n", r.names[k].c_str(), pixels);
+
+            if (out) {
+                std::string path = std::string(out) + "/" + r.names[k];
+
+                r.images[k].save_pbm(path);
+                if (pixels > 0)
+                    changed.save_pbm(path.substr(0, path.size() - 4) + ".diff.pbm");
+            }
+        }
+    }
+
+    printf("%u images, %u differ\n", checked, failed);
+
+    return failed ? 1 : 0;
+}
+
+static int usage()
+{
+    fprintf(stderr, "usage: th-screens list\n"
+                    "       th-screens dump <dir> [--png]\n"
+                    "       th-screens compare <golden dir> [--out dir]\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    size_t i;
+
+    if (argc == 2 && strcmp(argv[1], "list") == 0) {
+        for (i=0; i < SCREEN_CASES; i++)
+            printf("%-20s %s\n", cases[i].name, cases[i].description);
+        return 0;
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "dump") == 0) {
+        if (argc == 3 || (argc == 4 && strcmp(argv[3], "--png") == 0))
+            return dump(argv[2], argc == 4);
+    }
+    else if (argc >= 3 && strcmp(argv[1], "compare") == 0) {
+        if (argc == 3)
+            return compare(argv[2], NULL);
+        if (argc == 5 && strcmp(argv[3], "--out") == 0)
+            return compare(argv[2], argv[4]);
+    }
+
+    return usage();
+}
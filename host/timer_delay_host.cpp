@@ -0,0 +1,16 @@
+/*
+ * timer_delay_host.cpp : host implementation of lib/timer_delay
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      The delay only advances the virtual cycle counter (16MHz MCLK).
+ */
+
+#include <msp430.h>
+#include <lib/timer_delay.h>
+
+void timer_delay_ms(uint16_t ms)
+{
+    host_mcu->cycles += (uint64_t)ms * 16000;
+}
@@ -0,0 +1,51 @@
+/*
+ * uart_host.cpp : host backend of lib/uart.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: xtarke
+ *
+ *      Bytes written by the firmware are handed to the uart_tx_hook of
+ *      the calling context, as if the TX IRQ had already sent them.
+ */
+
+#include <msp430.h>
+
+#include <lib/uart.h>
+
+void init_uart()
+{
+}
+
+void uart_update_clock()
+{
+}
+
+uint8_t uart_write(const uint8_t *data, uint8_t count)
+{
+    /* Copy into the ring buffer: a few cycles per byte */
+    host_cpu_cycles(8 * count);
+
+    if (host_mcu->uart_tx_hook)
+        host_mcu->uart_tx_hook(host_mcu, data, count);
+
+    return count;
+}
+
+uint8_t uart_tx_busy()
+{
+    return 0;
+}
+
+void uart_flush()
+{
+}
+
+uint16_t uart_tx_overflows()
+{
+    return 0;
+}
+
+uint8_t uart_tx_isr()
+{
+    return 0;
+}